@@ -0,0 +1,39 @@
+// compile-time benchmark of building a long chain, compare the build time of the two targets:
+//   static_graph_chain_operator: n0 + n1 + ... + n(k-1)
+//   static_graph_chain_builder:  make_chain(n0, n1, ..., n(k-1))
+// the chain length can be changed with HRLIB_BENCHMARK_CHAIN_LENGTH.
+#include <utility>
+#include <type_traits>
+#include <hrlib/static_graph/static_graph.hpp>
+
+#ifndef HRLIB_BENCHMARK_CHAIN_LENGTH
+#define HRLIB_BENCHMARK_CHAIN_LENGTH 64
+#endif
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct bench_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr bench_node<NextNodeType> copy() const { return bench_node<NextNodeType>{value}; }
+  std::size_t value = 0;
+  constexpr bench_node(std::size_t val): base_type(), value(val) {}
+};
+
+template <std::size_t... Is>
+constexpr auto build(std::index_sequence<Is...>)
+{
+#ifdef HRLIB_BENCHMARK_USE_OPERATOR
+  return (... + bench_node<>{Is});
+#else
+  return hrlib::static_graph::make_chain(bench_node<>{Is}...);
+#endif
+}
+
+int main()
+{
+  constexpr auto graph = build(std::make_index_sequence<HRLIB_BENCHMARK_CHAIN_LENGTH>{});
+  static_assert(std::remove_const_t<decltype(graph)>::node_num == HRLIB_BENCHMARK_CHAIN_LENGTH);
+  static_assert(hrlib::static_graph::node_at<HRLIB_BENCHMARK_CHAIN_LENGTH - 1>(graph).value == HRLIB_BENCHMARK_CHAIN_LENGTH - 1);
+  return 0;
+}
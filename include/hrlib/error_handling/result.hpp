@@ -5,7 +5,11 @@
 #include <tuple>
 #include <functional>
 #include <variant>
+#include <cstdint>
+#include <new>
+#include <memory>
 #include <optional>
+#include <utility>
 #include <boost/optional.hpp>
 #include <hrlib/type_traits/type_traits.hpp>
 
@@ -49,6 +53,229 @@ namespace hrlib::error_handling {
             ~Err() = default;
         };
 
+        //a value of T which never holds a valid value, Result<T, E> uses it to represent the error state without a discriminator
+        //when E is an empty class. specialize this class with
+        //  static T niche_value() which makes the value
+        //  static bool is_niche(const T&) which checks it
+        //e.g. an out-of-range value of an enum.
+        template <typename T, typename = void>
+        struct Niche {};
+
+        //a pointer to a type whose alignment is greater than 1 is never 1, so nullptr is still a valid value of Ok
+        template <typename T>
+        struct Niche<T*, std::enable_if_t<(alignof(T) > 1)>> {
+            static T* niche_value() noexcept { return reinterpret_cast<T*>(std::uintptr_t{1}); }
+            static bool is_niche(T* const& ptr) noexcept { return reinterpret_cast<std::uintptr_t>(ptr) == 1; }
+        };
+
+        namespace detail {
+            template <typename T>
+            using niche_value_t = decltype(Niche<T>::niche_value());
+
+            template <typename T, typename E>
+            constexpr bool use_niche_v = type_traits::is_detected_v<niche_value_t, T> && std::is_empty_v<E> && !std::is_final_v<E>;
+
+            struct FromStorage {};
+
+            //a tagged union with a one byte discriminator, the destructor is trivial when both of the members are trivially destructible.
+            //the members are constructed by the constructors of this class, so that an exception thrown by them never reaches the destructor
+            template <typename OkType, typename ErrType, bool = std::is_trivially_destructible_v<OkType> && std::is_trivially_destructible_v<ErrType>>
+            struct UnionStorageBase {
+                union {
+                    OkType ok_value;
+                    ErrType err_value;
+                };
+                bool is_ok;
+                template <typename Ok_>
+                UnionStorageBase(std::in_place_index_t<0>, Ok_&& ok): ok_value(std::forward<Ok_>(ok)), is_ok(true) {}
+                template <typename Err_>
+                UnionStorageBase(std::in_place_index_t<1>, Err_&& err): err_value(std::forward<Err_>(err)), is_ok(false) {}
+                template <typename Storage>
+                UnionStorageBase(FromStorage, Storage&& other): is_ok(other.is_ok) {
+                    if(is_ok) ::new (static_cast<void*>(std::addressof(ok_value))) OkType(std::forward<Storage>(other).ok_value);
+                    else ::new (static_cast<void*>(std::addressof(err_value))) ErrType(std::forward<Storage>(other).err_value);
+                }
+                UnionStorageBase(const UnionStorageBase&) = default;
+                UnionStorageBase(UnionStorageBase&&) = default;
+                UnionStorageBase& operator=(const UnionStorageBase&) = default;
+                UnionStorageBase& operator=(UnionStorageBase&&) = default;
+                ~UnionStorageBase() = default;
+                void destroy() noexcept {}
+            };
+
+            template <typename OkType, typename ErrType>
+            struct UnionStorageBase<OkType, ErrType, false> {
+                union {
+                    OkType ok_value;
+                    ErrType err_value;
+                };
+                bool is_ok;
+                template <typename Ok_>
+                UnionStorageBase(std::in_place_index_t<0>, Ok_&& ok): ok_value(std::forward<Ok_>(ok)), is_ok(true) {}
+                template <typename Err_>
+                UnionStorageBase(std::in_place_index_t<1>, Err_&& err): err_value(std::forward<Err_>(err)), is_ok(false) {}
+                template <typename Storage>
+                UnionStorageBase(FromStorage, Storage&& other): is_ok(other.is_ok) {
+                    if(is_ok) ::new (static_cast<void*>(std::addressof(ok_value))) OkType(std::forward<Storage>(other).ok_value);
+                    else ::new (static_cast<void*>(std::addressof(err_value))) ErrType(std::forward<Storage>(other).err_value);
+                }
+                ~UnionStorageBase() { destroy(); }
+                void destroy() noexcept {
+                    if(is_ok) ok_value.~OkType();
+                    else err_value.~ErrType();
+                }
+            };
+
+            //the accessors of the union storage, copy and move are left to the derived class
+            template <typename OkType, typename ErrType>
+            struct UnionStorageCommon: UnionStorageBase<OkType, ErrType> {
+                using base_type = UnionStorageBase<OkType, ErrType>;
+                using base_type::base_type;
+                UnionStorageCommon(const OkType& ok) noexcept(std::is_nothrow_copy_constructible_v<OkType>): base_type(std::in_place_index<0>, ok) {}
+                UnionStorageCommon(OkType&& ok) noexcept(std::is_nothrow_move_constructible_v<OkType>): base_type(std::in_place_index<0>, std::move(ok)) {}
+                UnionStorageCommon(const ErrType& err) noexcept(std::is_nothrow_copy_constructible_v<ErrType>): base_type(std::in_place_index<1>, err) {}
+                UnionStorageCommon(ErrType&& err) noexcept(std::is_nothrow_move_constructible_v<ErrType>): base_type(std::in_place_index<1>, std::move(err)) {}
+                template <typename Storage>
+                void assign_from(Storage&& other) {
+                    //nothing restores the destroyed alternative, so the move constructors between destroy() and is_ok must not throw
+                    static_assert(std::is_nothrow_move_constructible_v<OkType> && std::is_nothrow_move_constructible_v<ErrType>,
+                                  "the assignment of a Result needs value types which are nothrow move constructible");
+                    if(this->is_ok && other.is_ok) this->ok_value = std::forward<Storage>(other).ok_value;
+                    else if(!this->is_ok && !other.is_ok) this->err_value = std::forward<Storage>(other).err_value;
+                    else {
+                        //the other alternative is copied before this one is destroyed, so a throwing copy leaves this one as it is
+                        base_type tmp(FromStorage{}, std::forward<Storage>(other));
+                        this->destroy();
+                        if(tmp.is_ok) ::new (static_cast<void*>(std::addressof(this->ok_value))) OkType(std::move(tmp.ok_value));
+                        else ::new (static_cast<void*>(std::addressof(this->err_value))) ErrType(std::move(tmp.err_value));
+                        this->is_ok = tmp.is_ok;
+                    }
+                }
+                bool has_ok() const noexcept { return this->is_ok; }
+                OkType& ok() & noexcept { return this->ok_value; }
+                const OkType& ok() const & noexcept { return this->ok_value; }
+                OkType&& ok() && noexcept { return std::move(this->ok_value); }
+                ErrType& err() & noexcept { return this->err_value; }
+                const ErrType& err() const & noexcept { return this->err_value; }
+                ErrType&& err() && noexcept { return std::move(this->err_value); }
+                auto& err_data() & noexcept { return this->err_value.err; }
+                const auto& err_data() const & noexcept { return this->err_value.err; }
+            };
+
+            //copy and move are trivial when both of the members are trivially copyable
+            template <typename OkType, typename ErrType, bool = std::is_trivially_copyable_v<OkType> && std::is_trivially_copyable_v<ErrType>>
+            struct UnionStorage: UnionStorageCommon<OkType, ErrType> {
+                using UnionStorageCommon<OkType, ErrType>::UnionStorageCommon;
+            };
+
+            //each one deletes one of the copy and move members of a class which defaults them, when its argument is false
+            template <bool>
+            struct EnableCopyConstruct {};
+            template <>
+            struct EnableCopyConstruct<false> {
+                EnableCopyConstruct() = default;
+                EnableCopyConstruct(const EnableCopyConstruct&) = delete;
+                EnableCopyConstruct(EnableCopyConstruct&&) = default;
+                EnableCopyConstruct& operator=(const EnableCopyConstruct&) = default;
+                EnableCopyConstruct& operator=(EnableCopyConstruct&&) = default;
+            };
+            template <bool>
+            struct EnableMoveConstruct {};
+            template <>
+            struct EnableMoveConstruct<false> {
+                EnableMoveConstruct() = default;
+                EnableMoveConstruct(const EnableMoveConstruct&) = default;
+                EnableMoveConstruct(EnableMoveConstruct&&) = delete;
+                EnableMoveConstruct& operator=(const EnableMoveConstruct&) = default;
+                EnableMoveConstruct& operator=(EnableMoveConstruct&&) = default;
+            };
+            template <bool>
+            struct EnableCopyAssign {};
+            template <>
+            struct EnableCopyAssign<false> {
+                EnableCopyAssign() = default;
+                EnableCopyAssign(const EnableCopyAssign&) = default;
+                EnableCopyAssign(EnableCopyAssign&&) = default;
+                EnableCopyAssign& operator=(const EnableCopyAssign&) = delete;
+                EnableCopyAssign& operator=(EnableCopyAssign&&) = default;
+            };
+            template <bool>
+            struct EnableMoveAssign {};
+            template <>
+            struct EnableMoveAssign<false> {
+                EnableMoveAssign() = default;
+                EnableMoveAssign(const EnableMoveAssign&) = default;
+                EnableMoveAssign(EnableMoveAssign&&) = default;
+                EnableMoveAssign& operator=(const EnableMoveAssign&) = default;
+                EnableMoveAssign& operator=(EnableMoveAssign&&) = delete;
+            };
+
+            //the copy and move of the tagged union, which the alternatives need not support
+            template <typename OkType, typename ErrType>
+            struct UnionStorageCopyMove: UnionStorageCommon<OkType, ErrType> {
+                using UnionStorageCommon<OkType, ErrType>::UnionStorageCommon;
+                UnionStorageCopyMove(const UnionStorageCopyMove& other) noexcept(std::is_nothrow_copy_constructible_v<OkType> && std::is_nothrow_copy_constructible_v<ErrType>)
+                    : UnionStorageCommon<OkType, ErrType>(FromStorage{}, other) {}
+                UnionStorageCopyMove(UnionStorageCopyMove&& other) noexcept(std::is_nothrow_move_constructible_v<OkType> && std::is_nothrow_move_constructible_v<ErrType>)
+                    : UnionStorageCommon<OkType, ErrType>(FromStorage{}, std::move(other)) {}
+                UnionStorageCopyMove& operator=(const UnionStorageCopyMove& other) {
+                    if(this != &other) this->assign_from(other);
+                    return *this;
+                }
+                UnionStorageCopyMove& operator=(UnionStorageCopyMove&& other) noexcept(std::is_nothrow_move_constructible_v<OkType> && std::is_nothrow_move_constructible_v<ErrType>
+                                                                                        && std::is_nothrow_move_assignable_v<OkType> && std::is_nothrow_move_assignable_v<ErrType>) {
+                    if(this != &other) this->assign_from(std::move(other));
+                    return *this;
+                }
+                ~UnionStorageCopyMove() = default;
+            };
+
+            //the defaulted members are deleted by the bases when the alternatives can not be copied or moved,
+            //an assignment between the alternatives constructs one of them, so it needs both construction and assignment
+            template <typename OkType, typename ErrType>
+            struct UnionStorage<OkType, ErrType, false>
+                : UnionStorageCopyMove<OkType, ErrType>,
+                  EnableCopyConstruct<std::is_copy_constructible_v<OkType> && std::is_copy_constructible_v<ErrType>>,
+                  EnableMoveConstruct<std::is_move_constructible_v<OkType> && std::is_move_constructible_v<ErrType>>,
+                  EnableCopyAssign<std::is_copy_constructible_v<OkType> && std::is_copy_constructible_v<ErrType>
+                                   && std::is_copy_assignable_v<OkType> && std::is_copy_assignable_v<ErrType>>,
+                  EnableMoveAssign<std::is_move_constructible_v<OkType> && std::is_move_constructible_v<ErrType>
+                                   && std::is_move_assignable_v<OkType> && std::is_move_assignable_v<ErrType>> {
+                using UnionStorageCopyMove<OkType, ErrType>::UnionStorageCopyMove;
+                UnionStorage(const UnionStorage&) = default;
+                UnionStorage(UnionStorage&&) = default;
+                UnionStorage& operator=(const UnionStorage&) = default;
+                UnionStorage& operator=(UnionStorage&&) = default;
+                ~UnionStorage() = default;
+            };
+
+            //the error state is the niche value of the ok value and the empty error value is a base class, so the storage is as large as the ok value
+            template <typename OkType, typename ErrType>
+            class NicheStorage: private ErrType::wrap_type {
+                using ok_wrap_type = typename OkType::wrap_type;
+                using error_wrap_type = typename ErrType::wrap_type;
+                OkType ok_value;
+            public:
+                NicheStorage(const OkType& ok) noexcept(std::is_nothrow_copy_constructible_v<OkType>): ok_value(ok) {}
+                NicheStorage(OkType&& ok) noexcept(std::is_nothrow_move_constructible_v<OkType>): ok_value(std::move(ok)) {}
+                NicheStorage(const ErrType& err): error_wrap_type(err.err), ok_value(Niche<ok_wrap_type>::niche_value()) {}
+                NicheStorage(ErrType&& err): error_wrap_type(std::move(err.err)), ok_value(Niche<ok_wrap_type>::niche_value()) {}
+                bool has_ok() const noexcept { return !Niche<ok_wrap_type>::is_niche(ok_value.data); }
+                OkType& ok() & noexcept { return ok_value; }
+                const OkType& ok() const & noexcept { return ok_value; }
+                OkType&& ok() && noexcept { return std::move(ok_value); }
+                ErrType err() const { return ErrType(err_data()); }
+                error_wrap_type& err_data() & noexcept { return *this; }
+                const error_wrap_type& err_data() const & noexcept { return *this; }
+            };
+
+            template <typename OkType, typename ErrType>
+            using ResultStorage = std::conditional_t<
+                use_niche_v<typename OkType::wrap_type, typename ErrType::wrap_type>,
+                NicheStorage<OkType, ErrType>,
+                UnionStorage<OkType, ErrType>
+            >;
+        }
     } 
 
     template <typename WrapType, typename ErrType = std::string>
@@ -59,25 +286,30 @@ namespace hrlib::error_handling {
         using Ok = result::Ok<ok_wrap_type>;
         using Err = result::Err<error_wrap_type>;
     private:
-        std::variant<Ok, Err> var;
+        //a tagged union, or only the ok value when the error state is a niche of it (see result::Niche)
+        result::detail::ResultStorage<Ok, Err> storage;
+        void check(bool is_ok) const {
+            if(static_cast<bool>(*this) != is_ok) throw std::bad_variant_access();
+        }
     public:
-        Result(const Ok& ok) noexcept(std::is_nothrow_copy_constructible_v<Ok>): var(ok){}
-        Result(Ok&& ok) noexcept(std::is_nothrow_move_constructible_v<Ok>): var(std::move(ok)){}
-        Result(const Err& err) noexcept(std::is_nothrow_copy_constructible_v<Err>): var(err){}
-        Result(Err&& err) noexcept(std::is_nothrow_move_constructible_v<Err>): var(std::move(err)){}
+        Result(const Ok& ok) noexcept(std::is_nothrow_copy_constructible_v<Ok>): storage(ok){}
+        Result(Ok&& ok) noexcept(std::is_nothrow_move_constructible_v<Ok>): storage(std::move(ok)){}
+        Result(const Err& err) noexcept(std::is_nothrow_copy_constructible_v<Err>): storage(err){}
+        Result(Err&& err) noexcept(std::is_nothrow_move_constructible_v<Err>): storage(std::move(err)){}
         Result(const Result&) = default;
         Result(Result&&) = default;
         Result& operator=(const Result&) = default;
         Result& operator=(Result&&) = default;
         ~Result() = default;
     public:
-        explicit operator bool()const noexcept { return std::get_if<Ok>(&var) != nullptr; }
-        ok_wrap_type& get_ok() &{ return std::get<Ok>(var).data; }
-        const ok_wrap_type& get_ok() const &{ return std::get<Ok>(var).data; }
-        ok_wrap_type&& get_ok() &&{ return std::move(std::get<Ok>(var).data); }
-        error_wrap_type& get_err() &{ return std::get<Err>(var).err; }
-        const error_wrap_type& get_err() const &{ return std::get<Err>(var).err; }
-        error_wrap_type&& get_err() &&{ return std::move(std::get<Err>(var)).err; }
+        explicit operator bool()const noexcept { return storage.has_ok(); }
+        //throws std::bad_variant_access when the other alternative is held
+        ok_wrap_type& get_ok() &{ check(true); return storage.ok().data; }
+        const ok_wrap_type& get_ok() const &{ check(true); return storage.ok().data; }
+        ok_wrap_type&& get_ok() &&{ check(true); return std::move(storage.ok().data); }
+        error_wrap_type& get_err() &{ check(false); return storage.err_data(); }
+        const error_wrap_type& get_err() const &{ check(false); return storage.err_data(); }
+        error_wrap_type&& get_err() &&{ check(false); return std::move(storage.err_data()); }
     public:
         template <typename Fn>
         auto ok_or(Fn fn) const& noexcept(std::is_nothrow_copy_constructible_v<ok_wrap_type> && std::is_nothrow_invocable_r_v<ok_wrap_type, Fn>)
@@ -95,7 +327,7 @@ namespace hrlib::error_handling {
                                                               && std::is_nothrow_constructible_v<Result<WrapType_, ErrType>, const result::Err<ErrType>&>){
             using ok_type = result::Ok<WrapType_>;
             using result_type = Result<WrapType_, ErrType>;
-            return (*this) ? result_type(ok_type(fn(std::get<Ok>(var).data))) : result_type(std::get<Err>(var));
+            return (*this) ? result_type(ok_type(fn(storage.ok().data))) : result_type(Err(storage.err_data()));
         }
         template <typename Fn, typename WrapType_ = std::decay_t<std::invoke_result_t<Fn, ok_wrap_type&&>>>
         Result<WrapType_, ErrType> map(Fn fn) && noexcept(std::is_nothrow_invocable_r_v<WrapType_, Fn, ok_wrap_type&&> 
@@ -103,7 +335,7 @@ namespace hrlib::error_handling {
                                                           && std::is_nothrow_constructible_v<Result<WrapType_, ErrType>, result::Err<ErrType>&&>){
             using ok_type = result::Ok<WrapType_>;
             using result_type = Result<WrapType_, ErrType>;
-            return (*this) ? result_type(ok_type(fn(std::move(std::get<Ok>(var).data)))) : result_type(std::get<Err>(std::move(var)));
+            return (*this) ? result_type(ok_type(fn(std::move(storage.ok().data)))) : result_type(Err(std::move(storage.err_data())));
         }                     
         template <
                   typename Fn, 
@@ -115,7 +347,7 @@ namespace hrlib::error_handling {
                  >
         Result_ flat_map(Fn fn) const& noexcept(std::is_nothrow_invocable_r_v<Result_, Fn, const ok_wrap_type&>
                                                 && std::is_nothrow_constructible_v<Result_, const Err&>) {
-            return (*this) ? fn(std::get<Ok>(var).data) : std::get<Err>(var);
+            return (*this) ? fn(storage.ok().data) : Result_(Err(storage.err_data()));
         }
         template <
                   typename Fn, 
@@ -127,13 +359,23 @@ namespace hrlib::error_handling {
                  >
         Result_ flat_map(Fn fn) && noexcept(std::is_nothrow_invocable_r_v<Result_, Fn, ok_wrap_type&&>
                                             && std::is_nothrow_constructible_v<Result_, Err&&>) {
-            return (*this) ? fn(std::move(std::get<Ok>(var).data)) : std::get<Err>(std::move(var));
+            return (*this) ? fn(std::move(storage.ok().data)) : Result_(Err(std::move(storage.err_data())));
         }
     public:
+        //calls the matcher with the held Ok or Err as a const lvalue or an rvalue, as std::visit does.
+        //the niche storage makes the Err on demand, it is held in a local so that the matcher gets the same value category
         template <typename Matcher>
-        decltype(auto) match(Matcher&& matcher) const& { return std::visit(std::forward<Matcher>(matcher), var); }
+        decltype(auto) match(Matcher&& matcher) const& {
+            if(*this) return std::forward<Matcher>(matcher)(storage.ok());
+            decltype(auto) err = storage.err();
+            return std::forward<Matcher>(matcher)(std::as_const(err));
+        }
         template <typename Matcher>
-        decltype(auto) match(Matcher&& matcher) && { return std::visit(std::forward<Matcher>(matcher), std::move(var)); }
+        decltype(auto) match(Matcher&& matcher) && {
+            if(*this) return std::forward<Matcher>(matcher)(std::move(storage).ok());
+            decltype(auto) err = std::move(storage).err();
+            return std::forward<Matcher>(matcher)(std::move(err));
+        }
     };
 
     namespace result {
@@ -0,0 +1,248 @@
+#ifndef HRLIB_STATIC_GRAPH_ASYNC_EXECUTOR
+#define HRLIB_STATIC_GRAPH_ASYNC_EXECUTOR
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    // counts the notifications of a run, the executor sleeps until the count differs from the one it saw before its last round of polls
+    class async_signal
+    {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::uint64_t count = 0;
+    public:
+      void notify()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          ++count;
+        }
+        cv.notify_one();
+      }
+      std::uint64_t current()
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+      }
+      // waits until a notification after seen, at most for timeout when it is given
+      void wait(std::uint64_t seen, std::optional<std::chrono::microseconds> timeout)
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (timeout)
+          cv.wait_for(lock, *timeout, [this, seen]{ return count != seen; });
+        else
+          cv.wait(lock, [this, seen]{ return count != seen; });
+      }
+    };
+  }
+
+  // wakes up the async_executor which waits for the operation it was given to
+  class async_notifier
+  {
+    detail::async_signal* signal;
+  public:
+    explicit async_notifier(detail::async_signal& signal) noexcept: signal(&signal) {}
+    void notify() const { signal->notify(); }
+  };
+
+  // runs a graph on the calling thread and overlaps nodes which wait, e.g. for local I/O.
+  // run(Args&...) of a node returns either void, when the node has finished, or a pending operation with
+  //   poll() -> bool: whether the work the node waits for is done, it must not block,
+  //   complete(): called once after poll() returned true, the node has finished then.
+  // and optionally
+  //   set_notifier(async_notifier): called once before the first poll(), the operation calls notify() of the notifier,
+  //   from any thread, when poll() may return true, e.g. from its I/O completion callback. it must not call it after poll() returned true.
+  // this is a polling protocol of its own, not the co_await one: no coroutine is suspended.
+  // while an operation is pending the path behind its node waits and the executor keeps running the other ready nodes,
+  // e.g. the other branches of an or_node. when nothing else is ready and a round of polls completed nothing, the thread blocks:
+  // until a notifier is notified when every pending operation has one, otherwise for a timeout which doubles
+  // from 1us to 1ms while nothing completes, so a wait for slow I/O does not keep a core busy.
+  // the operations live in a slot per node whose type is known at compile time, so a run allocates nothing on the heap.
+  namespace detail
+  {
+    template <typename Node, typename... Args>
+    using async_run_result_t = decltype(std::declval<Node&>().run(std::declval<Args&>()...));
+
+    template <typename Operation>
+    using set_notifier_member_t = decltype(std::declval<Operation&>().set_notifier(std::declval<async_notifier>()));
+
+    template <typename Operation>
+    using async_slot_t = std::conditional_t<std::is_void_v<Operation>, std::tuple<>, std::optional<Operation>>;
+
+    // whether the operation of a slot wakes the executor up by itself
+    template <typename Slot>
+    struct async_notifiable: std::true_type {};
+    template <typename Operation>
+    struct async_notifiable<std::optional<Operation>>: type_traits::is_detected<set_notifier_member_t, Operation> {};
+  }
+
+  template <typename Graph>
+  class async_executor
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    using table = detail::successor_table<Graph>;
+    using index_type = typename table::index_type;
+
+    template <typename Seq, typename... Args>
+    struct slots_impl;
+    template <std::size_t... Is, typename... Args>
+    struct slots_impl<std::index_sequence<Is...>, Args...>
+      : type_traits::identity<std::tuple<detail::async_slot_t<detail::async_run_result_t<node_at_t<Graph, Is>, Args...>>...>> {};
+
+    template <typename... Args>
+    struct run_state
+    {
+      Graph& graph;
+      std::tuple<Args&...> args;
+      typename slots_impl<std::make_index_sequence<node_num>, Args...>::type pending{};
+      std::array<index_type, node_num> join_counters = table::predecessor_counts;
+      std::array<index_type, node_num> ready{}; // every node is pushed once, so the queue never wraps around
+      std::size_t ready_first = 0;
+      std::size_t ready_last = 0;
+      std::array<index_type, node_num> waiting{};
+      std::size_t waiting_num = 0;
+      std::size_t finished_num = 0;
+      detail::async_signal signal;
+      run_state(Graph& graph, std::tuple<Args&...> args): graph(graph), args(args) {}
+    };
+
+    // runs the node, returns whether it has finished
+    template <typename State, std::size_t I>
+    static bool start_node(State& state)
+    {
+      auto& node = node_at<I>(state.graph);
+      if constexpr (std::is_same_v<std::tuple_element_t<I, decltype(state.pending)>, std::tuple<>>)
+      {
+        std::apply([&node](auto&... args){ node.run(args...); }, state.args);
+        return true;
+      }
+      else
+      {
+        auto& operation = std::get<I>(state.pending);
+        std::apply([&node, &operation](auto&... args){ operation.emplace(node.run(args...)); }, state.args);
+        if constexpr (detail::async_notifiable<std::remove_reference_t<decltype(operation)>>::value)
+          operation->set_notifier(async_notifier(state.signal));
+        return poll_node<State, I>(state);
+      }
+    }
+    // returns whether the pending node has finished
+    template <typename State, std::size_t I>
+    static bool poll_node(State& state)
+    {
+      if constexpr (std::is_same_v<std::tuple_element_t<I, decltype(state.pending)>, std::tuple<>>)
+        return true;
+      else
+      {
+        auto& operation = std::get<I>(state.pending);
+        if (!operation->poll())
+          return false;
+        operation->complete();
+        operation.reset();
+        return true;
+      }
+    }
+    template <typename State, std::size_t... Is>
+    static constexpr std::array<bool (*)(State&), node_num> make_start_table(std::index_sequence<Is...>) { return {{&start_node<State, Is>...}}; }
+    template <typename State, std::size_t... Is>
+    static constexpr std::array<bool (*)(State&), node_num> make_poll_table(std::index_sequence<Is...>) { return {{&poll_node<State, Is>...}}; }
+    template <typename State>
+    static constexpr auto start_table = make_start_table<State>(std::make_index_sequence<node_num>{});
+    template <typename State>
+    static constexpr auto poll_table = make_poll_table<State>(std::make_index_sequence<node_num>{});
+    template <typename State, std::size_t... Is>
+    static constexpr std::array<bool, node_num> make_notifiable_table(std::index_sequence<Is...>)
+    {
+      return {{detail::async_notifiable<std::tuple_element_t<Is, decltype(std::declval<State&>().pending)>>::value...}};
+    }
+    template <typename State>
+    static constexpr auto notifiable_table = make_notifiable_table<State>(std::make_index_sequence<node_num>{});
+
+    static constexpr std::chrono::microseconds min_timeout{1};
+    static constexpr std::chrono::microseconds max_timeout{1000};
+
+    template <typename State>
+    static void finish(State& state, std::size_t index)
+    {
+      ++state.finished_num;
+      for (auto i = table::successor_offsets[index]; i < table::successor_offsets[index + 1]; ++i)
+      {
+        const auto successor = table::successors[i];
+        if (--state.join_counters[successor] == 0)
+          state.ready[state.ready_last++] = successor;
+      }
+    }
+  public:
+    async_executor() = default;
+    template <typename... Args>
+    void run(Graph& graph, Args&&... args) const
+    {
+      using state_type = run_state<std::remove_reference_t<Args>...>;
+      state_type state(graph, std::tie(args...));
+      for (std::size_t i = 0; i < node_num; ++i)
+        if (table::predecessor_counts[i] == 0)
+          state.ready[state.ready_last++] = static_cast<index_type>(i);
+      auto timeout = min_timeout;
+      while (state.finished_num != node_num)
+      {
+        // a notification after this point is not lost when it comes before the wait below
+        const auto seen = state.signal.current();
+        while (state.ready_first != state.ready_last)
+        {
+          const auto index = state.ready[state.ready_first++];
+          if (start_table<state_type>[index](state))
+            finish(state, index);
+          else
+            state.waiting[state.waiting_num++] = index;
+        }
+        bool resumed = false;
+        for (std::size_t i = 0; i < state.waiting_num;)
+        {
+          const auto index = state.waiting[i];
+          if (!poll_table<state_type>[index](state))
+          {
+            ++i;
+            continue;
+          }
+          state.waiting[i] = state.waiting[--state.waiting_num];
+          finish(state, index);
+          resumed = true;
+        }
+        if (resumed || state.waiting_num == 0)
+        {
+          timeout = min_timeout;
+          continue;
+        }
+        bool notifiable = true;
+        for (std::size_t i = 0; i < state.waiting_num; ++i)
+          notifiable = notifiable && notifiable_table<state_type>[state.waiting[i]];
+        if (notifiable)
+          state.signal.wait(seen, std::nullopt);
+        else
+        {
+          state.signal.wait(seen, timeout);
+          timeout = timeout * 2 < max_timeout ? timeout * 2 : max_timeout;
+        }
+      }
+    }
+  };
+}
+
+#endif
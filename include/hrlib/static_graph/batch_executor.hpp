@@ -0,0 +1,217 @@
+#ifndef HRLIB_STATIC_GRAPH_BATCH_EXECUTOR
+#define HRLIB_STATIC_GRAPH_BATCH_EXECUTOR
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/span.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    // the predecessor of the head nodes
+    inline constexpr std::size_t graph_input = static_cast<std::size_t>(-1);
+
+    template <typename Graph>
+    struct batch_table
+    {
+    private:
+      using table = successor_table<Graph>;
+      static constexpr auto make_multiplicities()
+      {
+        std::array<std::size_t, Graph::node_num> res{};
+        for (std::size_t i = 0; i < Graph::node_num; ++i)
+        {
+          if (table::predecessor_counts[i] == 0)
+            res[i] = 1;
+          for (auto j = table::successor_offsets[i]; j < table::successor_offsets[i + 1]; ++j)
+            res[table::successors[j]] += res[i];
+        }
+        return res;
+      }
+    public:
+      // the number of records a node produces per input record, a node after an or_node processes the output of every branch
+      static constexpr auto multiplicities = make_multiplicities();
+      // the last successor of a node is run after the others, so it may move from the output of the node
+      static constexpr bool is_last_successor(std::size_t from, std::size_t to)
+      {
+        if (from == graph_input)
+          return topology_impl<Graph>::heads[topology_impl<Graph>::heads.size() - 1] == to;
+        return table::successors[table::successor_offsets[from + 1] - 1] == to;
+      }
+      static constexpr std::size_t first_predecessor(std::size_t node)
+      {
+        return table::predecessor_counts[node] == 0 ? graph_input : table::predecessors[table::predecessor_offsets[node]];
+      }
+    };
+
+    template <typename Graph, typename In, std::size_t I>
+    struct batch_node_types;
+    template <typename Graph, typename In, std::size_t P>
+    struct batch_source: type_traits::identity<typename batch_node_types<Graph, In, P>::value_type> {};
+    template <typename Graph, typename In>
+    struct batch_source<Graph, In, graph_input>: type_traits::identity<In> {};
+
+    // the types on the edge from P to I, the same as the types dataflow_executor passes
+    template <typename Graph, typename In, std::size_t I, std::size_t P>
+    struct batch_edge_types
+    {
+      using source_type = typename batch_source<Graph, In, P>::type;
+      static constexpr bool is_moved = batch_table<Graph>::is_last_successor(P, I);
+      using element_type = std::conditional_t<is_moved, source_type, const source_type>;
+      using input_type = std::conditional_t<is_moved, source_type&&, const source_type&>;
+      using output_type = process_result_t<node_at_t<Graph, I>, input_type>;
+    };
+    template <typename Graph, typename In, std::size_t I>
+    struct batch_node_types
+    {
+      using value_type = std::decay_t<typename batch_edge_types<Graph, In, I, batch_table<Graph>::first_predecessor(I)>::output_type>;
+    };
+
+    struct no_output {};
+
+    template <typename Node, typename InSpan, typename OutSpan>
+    using process_batch_result_t = decltype(std::declval<Node&>().process_batch(std::declval<InSpan>(), std::declval<OutSpan>()));
+    template <typename Node, typename InSpan>
+    using process_batch_sink_result_t = decltype(std::declval<Node&>().process_batch(std::declval<InSpan>()));
+  }
+
+  // runs a dataflow graph (see dataflow.hpp) over blocks of records, every node processes a whole block before the next node runs.
+  // nodes run in topological order, a node reads the output block of its predecessors and writes its own output block.
+  // a node may provide process_batch(span<In>, span<Out>) (process_batch(span<In>) if its output is void), otherwise process() is called in a loop.
+  // process() still defines the edge types. the output types must be default constructible, the output buffers are allocated once.
+  // the input records are only constructed from the range, In needs no default constructor or assignment.
+  // the input span holds const elements unless the node is the last successor of its predecessor, which may move from them.
+  // a node after an or_node processes the block of every branch and the sink gets the output block of each last node.
+  template <typename Graph, typename In, std::size_t BatchSize = 256>
+  class batch_executor
+  {
+    static_assert(BatchSize > 0);
+    static_assert(is_dataflow_graph_v<Graph, In>, "the output type of a node does not match the input type of its successor");
+  public:
+    using graph_type = Graph;
+    using input_type = In;
+    static constexpr std::size_t node_num = Graph::node_num;
+    static constexpr std::size_t batch_size = BatchSize;
+    template <std::size_t I>
+    using value_type = typename detail::batch_node_types<Graph, In, I>::value_type;
+  private:
+    using table = detail::successor_table<Graph>;
+    using batch_table = detail::batch_table<Graph>;
+    template <std::size_t I>
+    using buffer_element_type = std::conditional_t<std::is_void_v<value_type<I>>, detail::no_output, value_type<I>>;
+    template <typename Seq>
+    struct buffers_impl;
+    template <std::size_t... Is>
+    struct buffers_impl<std::index_sequence<Is...>>
+    {
+      using type = std::tuple<std::vector<buffer_element_type<Is>>...>;
+    };
+
+    std::vector<In> input;
+    typename buffers_impl<std::make_index_sequence<node_num>>::type buffers;
+
+    template <std::size_t I, std::size_t P>
+    auto source_span(std::size_t n)
+    {
+      using element_type = typename detail::batch_edge_types<Graph, In, I, P>::element_type;
+      if constexpr (P == detail::graph_input)
+        return span<element_type>(input.data(), n);
+      else
+        return span<element_type>(std::get<P>(buffers).data(), batch_table::multiplicities[P] * n);
+    }
+    template <std::size_t I, std::size_t P>
+    void run_segment(Graph& graph, std::size_t n, std::size_t& offset)
+    {
+      using edge = detail::batch_edge_types<Graph, In, I, P>;
+      using node_type = node_at_t<Graph, I>;
+      using in_span = span<typename edge::element_type>;
+      static_assert(
+        std::is_same_v<std::decay_t<typename edge::output_type>, value_type<I>>,
+        "a node after an or_node must produce the same output type from every branch"
+      );
+      auto& node = node_at<I>(graph);
+      auto source = source_span<I, P>(n);
+      if constexpr (std::is_void_v<value_type<I>>)
+      {
+        if constexpr (type_traits::is_detected_v<detail::process_batch_sink_result_t, node_type, in_span>)
+          node.process_batch(source);
+        else
+          for (auto& record: source)
+            node.process(static_cast<typename edge::input_type>(record));
+      }
+      else
+      {
+        span<value_type<I>> dest(std::get<I>(buffers).data() + offset, source.size());
+        if constexpr (type_traits::is_detected_v<detail::process_batch_result_t, node_type, in_span, span<value_type<I>>>)
+          node.process_batch(source, dest);
+        else
+          for (std::size_t i = 0; i < source.size(); ++i)
+            dest[i] = node.process(static_cast<typename edge::input_type>(source[i]));
+      }
+      offset += source.size();
+    }
+    template <std::size_t I, std::size_t... Ks>
+    void run_node(Graph& graph, std::size_t n, std::index_sequence<Ks...>)
+    {
+      std::size_t offset = 0;
+      if constexpr (sizeof...(Ks) == 0)
+        run_segment<I, detail::graph_input>(graph, n, offset);
+      else
+        (run_segment<I, table::predecessors[table::predecessor_offsets[I] + Ks]>(graph, n, offset), ...);
+    }
+    template <std::size_t I, typename Sink>
+    void flush_node(std::size_t n, Sink& sink)
+    {
+      if constexpr (table::successor_offsets[I] == table::successor_offsets[I + 1] && !std::is_void_v<value_type<I>>)
+        sink(span<value_type<I>>(std::get<I>(buffers).data(), batch_table::multiplicities[I] * n));
+    }
+    template <typename Sink, std::size_t... Is>
+    void run_batch(Graph& graph, std::size_t n, Sink& sink, std::index_sequence<Is...>)
+    {
+      (run_node<Is>(graph, n, std::make_index_sequence<table::predecessor_counts[Is]>{}), ...);
+      (flush_node<Is>(n, sink), ...);
+    }
+    template <std::size_t... Is>
+    void allocate(std::index_sequence<Is...>)
+    {
+      (std::get<Is>(buffers).resize(std::is_void_v<value_type<Is>> ? 0 : batch_table::multiplicities[Is] * BatchSize), ...);
+    }
+  public:
+    batch_executor()
+    {
+      input.reserve(BatchSize);
+      allocate(std::make_index_sequence<node_num>{});
+    }
+    // streams every record of the range through the graph in blocks of BatchSize records
+    template <typename Range, typename Sink>
+    void run(Graph& graph, Range&& records, Sink&& sink)
+    {
+      input.clear();
+      for (auto&& record: records)
+      {
+        input.emplace_back(std::forward<decltype(record)>(record));
+        if (input.size() == BatchSize)
+        {
+          run_batch(graph, BatchSize, sink, std::make_index_sequence<node_num>{});
+          input.clear();
+        }
+      }
+      if (!input.empty())
+        run_batch(graph, input.size(), sink, std::make_index_sequence<node_num>{});
+      input.clear();
+    }
+    template <typename Range>
+    void run(Graph& graph, Range&& records) { run(graph, std::forward<Range>(records), detail::discard_sink{}); }
+  };
+}
+
+#endif
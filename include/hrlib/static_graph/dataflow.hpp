@@ -0,0 +1,137 @@
+#ifndef HRLIB_STATIC_GRAPH_DATAFLOW
+#define HRLIB_STATIC_GRAPH_DATAFLOW
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  // dataflow mode, every single node provides process(In) -> Out.
+  // a record pushed into a graph is passed to the head nodes, and the output of a node is passed to its successors.
+  // a node with one successor passes its output by move.
+  // a node with several successors (the branches of an or_node) broadcasts its output by const reference and moves it into the last one.
+  // a node after an or_node processes the output of every branch, once per branch.
+  // the outputs of the last nodes are passed to the sink, a node returning void must be a last node.
+  namespace detail
+  {
+    template <typename Node, typename In>
+    using process_result_t = decltype(std::declval<Node&>().process(std::declval<In>()));
+
+    template <typename Graph, typename Out, typename Seq>
+    struct dataflow_successors_check;
+    template <typename Graph, std::size_t I, typename In, bool = type_traits::is_detected_v<process_result_t, node_at_t<Graph, I>, In>>
+    struct dataflow_node_check: std::false_type {};
+    template <typename Graph, std::size_t I, typename In>
+    struct dataflow_node_check<Graph, I, In, true>
+      : dataflow_successors_check<Graph, process_result_t<node_at_t<Graph, I>, In>, successors_t<Graph, I>> {};
+
+    template <typename Graph, typename Out>
+    struct dataflow_successors_check<Graph, Out, std::index_sequence<>>: std::true_type {};
+    template <typename Graph, typename Out, std::size_t J>
+    struct dataflow_successors_check<Graph, Out, std::index_sequence<J>>
+      : std::conjunction<
+          std::negation<std::is_void<Out>>,
+          dataflow_node_check<Graph, J, std::add_rvalue_reference_t<Out>>
+        > {};
+    template <typename Graph, typename Out, std::size_t J1, std::size_t J2, std::size_t... Js>
+    struct dataflow_successors_check<Graph, Out, std::index_sequence<J1, J2, Js...>>
+      : std::conjunction<
+          std::negation<std::is_void<Out>>,
+          dataflow_node_check<Graph, J1, std::add_lvalue_reference_t<std::add_const_t<std::remove_reference_t<Out>>>>,
+          dataflow_successors_check<Graph, Out, std::index_sequence<J2, Js...>>
+        > {};
+
+    struct discard_sink
+    {
+      template <typename T>
+      constexpr void operator()(T&&) const {}
+    };
+  }
+
+  // whether a record of type In can be pushed through Graph, the edge types are checked along the links of the graph
+  template <typename Graph, typename In>
+  struct is_dataflow_graph: detail::dataflow_successors_check<Graph, In, head_indices_t<Graph>> {};
+  template <typename Graph, typename In>
+  constexpr bool is_dataflow_graph_v = is_dataflow_graph<Graph, In>::value;
+
+  namespace detail
+  {
+    template <typename Graph, typename Out, typename Seq>
+    struct dataflow_result_impl;
+    template <typename Graph, std::size_t I, typename In>
+    struct dataflow_node_result: dataflow_result_impl<Graph, process_result_t<node_at_t<Graph, I>, In>, successors_t<Graph, I>> {};
+    template <typename Graph, typename Out>
+    struct dataflow_result_impl<Graph, Out, std::index_sequence<>>: type_traits::identity<std::decay_t<Out>> {};
+    template <typename Graph, typename Out, std::size_t J>
+    struct dataflow_result_impl<Graph, Out, std::index_sequence<J>>: dataflow_node_result<Graph, J, std::add_rvalue_reference_t<Out>> {};
+    template <typename Graph, typename Out, std::size_t J1, std::size_t J2, std::size_t... Js>
+    struct dataflow_result_impl<Graph, Out, std::index_sequence<J1, J2, Js...>>
+      : dataflow_node_result<Graph, J1, std::add_lvalue_reference_t<std::add_const_t<std::remove_reference_t<Out>>>> {};
+  }
+
+  // the decayed type of the records a graph passes to the sink, taken from the first last node.
+  template <typename Graph, typename In>
+  struct dataflow_result: detail::dataflow_result_impl<Graph, In, head_indices_t<Graph>> {};
+  template <typename Graph, typename In>
+  using dataflow_result_t = typename dataflow_result<Graph, In>::type;
+
+  template <typename Graph>
+  class dataflow_executor
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    template <typename T, typename Sink, std::size_t J, std::size_t... Js>
+    static constexpr void push_nodes(Graph& graph, T&& record, Sink& sink, std::index_sequence<J, Js...>)
+    {
+      if constexpr (sizeof...(Js) == 0)
+        push_node<J>(graph, std::forward<T>(record), sink);
+      else
+      {
+        push_node<J>(graph, std::as_const(record), sink);
+        push_nodes(graph, std::forward<T>(record), sink, std::index_sequence<Js...>{});
+      }
+    }
+    template <std::size_t I, typename T, typename Sink>
+    static constexpr void push_node(Graph& graph, T&& record, Sink& sink)
+    {
+      using successor_indices = successors_t<Graph, I>;
+      if constexpr (std::is_void_v<detail::process_result_t<node_at_t<Graph, I>, T&&>>)
+        node_at<I>(graph).process(std::forward<T>(record));
+      else
+      {
+        auto&& out = node_at<I>(graph).process(std::forward<T>(record));
+        if constexpr (successor_indices::size() == 0)
+          sink(std::forward<decltype(out)>(out));
+        else
+          push_nodes(graph, std::forward<decltype(out)>(out), sink, successor_indices{});
+      }
+    }
+  public:
+    constexpr dataflow_executor() = default;
+    template <typename T, typename Sink>
+    constexpr void push(Graph& graph, T&& record, Sink&& sink) const
+    {
+      static_assert(is_dataflow_graph_v<Graph, T&&>, "the output type of a node does not match the input type of its successor");
+      push_nodes(graph, std::forward<T>(record), sink, head_indices_t<Graph>{});
+    }
+    template <typename T>
+    constexpr void push(Graph& graph, T&& record) const { push(graph, std::forward<T>(record), detail::discard_sink{}); }
+    // streams every record of the range through the graph
+    template <typename Range, typename Sink>
+    constexpr void run(Graph& graph, Range&& records, Sink&& sink) const
+    {
+      for (auto&& record: records)
+        push(graph, std::forward<decltype(record)>(record), sink);
+    }
+    template <typename Range>
+    constexpr void run(Graph& graph, Range&& records) const { run(graph, std::forward<Range>(records), detail::discard_sink{}); }
+  };
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef HRLIB_STATIC_GRAPH_EXECUTOR
+#define HRLIB_STATIC_GRAPH_EXECUTOR
+
+#include <utility>
+#include <cstddef>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/instrumentation.hpp>
+
+namespace hrlib::static_graph
+{
+  // runs every single node of a graph once in topological order.
+  // the graph is lowered at compile time into a table indexed by the flat node index,
+  // so running the graph does not follow the next pointers of the nodes and construct_connection() is not needed.
+  // each node must provide run(Args&...), the arguments given to the executor are passed to every node.
+  // Instrumentation is called around every node, see instrumentation.hpp.
+  template <typename Graph, typename Instrumentation = no_instrumentation>
+  class flat_executor
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+    static constexpr const auto& successor_offsets = detail::successor_table<Graph>::successor_offsets;
+    static constexpr const auto& successors = detail::successor_table<Graph>::successors;
+  private:
+    Instrumentation instrumentation;
+    template <std::size_t I, typename... Args>
+    constexpr void run_node(Graph& graph, Args&... args) const
+    {
+      instrumentation.on_enter(I);
+      node_at<I>(graph).run(args...);
+      instrumentation.on_exit(I);
+    }
+    template <typename... Args, std::size_t... Is>
+    constexpr void run_impl(Graph& graph, std::index_sequence<Is...>, Args&... args) const
+    {
+      (run_node<Is>(graph, args...), ...);
+    }
+  public:
+    constexpr flat_executor(): instrumentation() {}
+    constexpr explicit flat_executor(const Instrumentation& instrumentation): instrumentation(instrumentation) {}
+    template <typename... Args>
+    constexpr void run(Graph& graph, Args&&... args) const { run_impl(graph, std::make_index_sequence<node_num>{}, args...); }
+  };
+}
+
+#endif
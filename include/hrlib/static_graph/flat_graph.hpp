@@ -0,0 +1,131 @@
+#ifndef HRLIB_STATIC_GRAPH_FLAT_GRAPH
+#define HRLIB_STATIC_GRAPH_FLAT_GRAPH
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  struct flat_graph_tag{};
+
+  namespace detail
+  {
+    // the single nodes one after another in the order of their members, unlike std::tuple whose layout is unspecified
+    // (libstdc++ places the last element first)
+    template <typename N, typename... Ns>
+    struct flat_storage
+    {
+      N node;
+      flat_storage<Ns...> rest;
+      template <typename Arg, typename... Args>
+      constexpr flat_storage(Arg&& arg, Args&&... args): node(std::forward<Arg>(arg)), rest(std::forward<Args>(args)...) {}
+      template <std::size_t I>
+      constexpr auto& get()
+      {
+        if constexpr (I == 0)
+          return node;
+        else
+          return rest.template get<I - 1>();
+      }
+      template <std::size_t I>
+      constexpr const auto& get() const
+      {
+        if constexpr (I == 0)
+          return node;
+        else
+          return rest.template get<I - 1>();
+      }
+    };
+    template <typename N>
+    struct flat_storage<N>
+    {
+      N node;
+      template <typename Arg>
+      constexpr flat_storage(Arg&& arg): node(std::forward<Arg>(arg)) {}
+      template <std::size_t I>
+      constexpr auto& get() { static_assert(I == 0); return node; }
+      template <std::size_t I>
+      constexpr const auto& get() const { static_assert(I == 0); return node; }
+    };
+
+    template <typename TypeList>
+    struct flat_storage_type;
+    template <typename... Ns>
+    struct flat_storage_type<type_list<Ns...>>: type_traits::identity<flat_storage<Ns...>> {};
+  }
+
+  // a graph whose single nodes are stored contiguously in the order of their flat indices, which is the execution order of flat_executor.
+  // the nested chained_node/or_node layout is gone, node_at and the topology (successors_t, adjacency, ...) see the same graph as for Graph,
+  // so the executors built on them (flat_executor, dataflow_executor, ...) run a flat_graph<Graph> like a Graph
+  // and a sequential run walks through memory in one direction. pipeline_executor needs the chained_node layout and does not take a flat_graph.
+  // pointer linked nodes must be connected with construct_connection() after the flat_graph is created, copied or moved, as for Graph.
+  template <typename Graph>
+  class flat_graph
+  {
+  public:
+    using node_type_tag = flat_graph_tag;
+    using graph_type = Graph;
+    using storage_type = typename detail::flat_storage_type<flat_nodes_t<Graph>>::type;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    storage_type storage;
+
+    template <typename G, std::size_t... Is>
+    constexpr flat_graph(G&& graph, std::index_sequence<Is...>)
+      : storage(std::move(node_at<Is>(graph))...)
+    {
+      static_assert(std::is_same_v<std::decay_t<G>, Graph>);
+    }
+    template <std::size_t... Is>
+    constexpr flat_graph(const Graph& graph, std::index_sequence<Is...>)
+      : storage(node_at<Is>(graph)...) {}
+
+    template <std::size_t I, std::size_t... Js>
+    constexpr void connect(std::index_sequence<Js...>)
+    {
+      using node_type = node_at_t<Graph, I>;
+      if constexpr (sizeof...(Js) == 0 || is_index_linked_v<node_type>)
+        ; // a last node links to the terminal node, an index linked node holds nothing
+      else if constexpr (sizeof...(Js) == 1)
+        get<I>().next = &get<(Js + ...)>();
+      else
+        get<I>().next = typename node_type::next_hold_type(&get<Js>()...);
+    }
+    template <std::size_t... Is>
+    constexpr void construct_connection_impl(std::index_sequence<Is...>) { (connect<Is>(successors_t<Graph, Is>{}), ...); }
+  public:
+    constexpr explicit flat_graph(const Graph& graph): flat_graph(graph, std::make_index_sequence<node_num>{}) {}
+    constexpr explicit flat_graph(Graph&& graph): flat_graph(std::move(graph), std::make_index_sequence<node_num>{}) {}
+    template <std::size_t I>
+    constexpr auto& get() & { return storage.template get<I>(); }
+    template <std::size_t I>
+    constexpr const auto& get() const & { return storage.template get<I>(); }
+    constexpr storage_type& get_storage() & { return storage; }
+    constexpr const storage_type& get_storage() const & { return storage; }
+    // sets the pointers of pointer linked nodes to the successors in this storage
+    constexpr void construct_connection() { construct_connection_impl(std::make_index_sequence<node_num>{}); }
+  };
+
+  template <typename Graph>
+  constexpr auto flatten(Graph&& graph) { return flat_graph<std::decay_t<Graph>>(std::forward<Graph>(graph)); }
+
+  namespace detail
+  {
+    template <typename FlatGraph>
+    struct flat_nodes_impl<FlatGraph, flat_graph_tag>
+    {
+      using type = flat_nodes_t<typename FlatGraph::graph_type>;
+      template <std::size_t I, typename N>
+      static constexpr auto& get(N& node) { return node.template get<I>(); }
+    };
+    template <typename FlatGraph>
+    struct topology_impl<FlatGraph, flat_graph_tag>: topology_impl<typename FlatGraph::graph_type> {};
+  }
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef HRLIB_STATIC_GRAPH_FUSION
+#define HRLIB_STATIC_GRAPH_FUSION
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    template <typename Node, typename = void>
+    struct fused_count: std::integral_constant<std::size_t, 1> {};
+    template <typename Node>
+    struct fused_count<Node, std::void_t<decltype(Node::fused_node_num)>>: std::integral_constant<std::size_t, Node::fused_node_num> {};
+
+    template <typename In, typename Tpl, typename = void>
+    struct fused_process_result {};
+    template <typename In, typename N>
+    struct fused_process_result<In, std::tuple<N>, std::void_t<process_result_t<N, In>>>
+      : type_traits::identity<process_result_t<N, In>> {};
+    template <typename In, typename N1, typename N2, typename... Ns>
+    struct fused_process_result<In, std::tuple<N1, N2, Ns...>, std::void_t<process_result_t<N1, In>>>
+      : fused_process_result<process_result_t<N1, In>, std::tuple<N2, Ns...>> {};
+    template <typename In, typename... Ns>
+    struct fused_process_result<In, const std::tuple<Ns...>>: fused_process_result<In, std::tuple<const Ns...>> {};
+  }
+
+  // a single node which runs a sequence of single nodes, made by fuse().
+  // run(Args&...) runs every node in order and process(In) passes the output of a node directly to the next one,
+  // so the sequence is one inlined call without any hand-off between the nodes.
+  // node_num is 1 as for any single node, fused_node_num is the number of the original nodes.
+  template <typename Next, typename N1, typename N2, typename... Ns>
+  struct fused_node: single_node_base<Next, link_tag_t<typename type_traits::last<type_list<N1, N2, Ns...>>::type>>
+  {
+    using base_type = single_node_base<Next, link_tag_t<typename type_traits::last<type_list<N1, N2, Ns...>>::type>>;
+    using content_type = std::tuple<N1, N2, Ns...>;
+    static constexpr std::size_t fused_node_num = detail::fused_count<N1>::value + detail::fused_count<N2>::value + (detail::fused_count<Ns>::value + ... + 0);
+    content_type ns;
+    constexpr fused_node(const content_type& ns): base_type(), ns(ns) {}
+    constexpr fused_node(content_type&& ns): base_type(), ns(std::move(ns)) {}
+  private:
+    template <std::size_t I, typename Nodes, typename In>
+    static constexpr decltype(auto) process_impl(Nodes& nodes, In&& in)
+    {
+      if constexpr (I == sizeof...(Ns) + 1)
+        return std::get<I>(nodes).process(std::forward<In>(in));
+      else
+        return process_impl<I + 1>(nodes, std::get<I>(nodes).process(std::forward<In>(in)));
+    }
+    template <std::size_t... Is, typename... Args>
+    constexpr void run_impl(std::index_sequence<Is...>, Args&... args) { (std::get<Is>(ns).run(args...), ...); }
+  public:
+    constexpr content_type& get_fused_nodes() & { return ns; }
+    constexpr const content_type& get_fused_nodes() const & { return ns; }
+    template <typename NextNodeType>
+    constexpr fused_node<NextNodeType, N1, N2, Ns...> copy() const { return fused_node<NextNodeType, N1, N2, Ns...>(ns); }
+    template <typename NextNodeType>
+    constexpr fused_node<NextNodeType, N1, N2, Ns...> rebind() && { return fused_node<NextNodeType, N1, N2, Ns...>(std::move(ns)); }
+    template <typename... Args>
+    constexpr void run(Args&... args) { run_impl(std::make_index_sequence<sizeof...(Ns) + 2>{}, args...); }
+    template <typename In>
+    constexpr typename detail::fused_process_result<In&&, content_type>::type process(In&& in) { return process_impl<0>(ns, std::forward<In>(in)); }
+    template <typename In>
+    constexpr typename detail::fused_process_result<In&&, const content_type>::type process(In&& in) const { return process_impl<0>(ns, std::forward<In>(in)); }
+  };
+
+  namespace detail
+  {
+    template <typename Run>
+    constexpr auto flush_fused_run(Run&& run)
+    {
+      if constexpr (std::tuple_size_v<std::decay_t<Run>> <= 1)
+        return std::forward<Run>(run);
+      else
+        return std::make_tuple(
+          std::apply([](auto&&... ns){ return fused_node<terminal_node, std::decay_t<decltype(ns)>...>(std::make_tuple(std::forward<decltype(ns)>(ns)...)); }, std::forward<Run>(run))
+        );
+    }
+  }
+
+  // rewrites a graph so that every run of consecutive single nodes in a chained_node becomes one fused_node.
+  // inside such a run every node but the first has exactly one predecessor and every node but the last exactly one successor.
+  // the result has the same topology with fewer single nodes, unfused_node_num_v gives the number of the original nodes.
+  template <typename Node>
+  constexpr auto fuse(Node&& node);
+
+  namespace detail
+  {
+    template <std::size_t I, typename Chain, typename Pieces, typename Run>
+    constexpr auto fuse_chain(Chain&& chain, Pieces&& pieces, Run&& run)
+    {
+      using content_type = typename std::decay_t<Chain>::content_type;
+      if constexpr (I == std::tuple_size_v<content_type>)
+        return std::tuple_cat(std::forward<Pieces>(pieces), flush_fused_run(std::forward<Run>(run)));
+      else
+      {
+        using element_type = std::tuple_element_t<I, content_type>;
+        auto&& element = std::get<I>(std::forward<Chain>(chain).get_nodes());
+        if constexpr (std::is_same_v<typename element_type::node_type_tag, single_node_tag>)
+          return fuse_chain<I + 1>(
+            std::forward<Chain>(chain),
+            std::forward<Pieces>(pieces),
+            std::tuple_cat(std::forward<Run>(run), std::make_tuple(std::forward<decltype(element)>(element)))
+          );
+        else
+          return fuse_chain<I + 1>(
+            std::forward<Chain>(chain),
+            std::tuple_cat(std::forward<Pieces>(pieces), flush_fused_run(std::forward<Run>(run)), std::make_tuple(fuse(std::forward<decltype(element)>(element)))),
+            std::tuple<>{}
+          );
+      }
+    }
+  }
+
+  template <typename Node>
+  constexpr auto fuse(Node&& node)
+  {
+    using NodeType = std::decay_t<Node>;
+    if constexpr (std::is_same_v<typename NodeType::node_type_tag, single_node_tag>)
+      return NodeType(std::forward<Node>(node));
+    else if constexpr (std::is_same_v<typename NodeType::node_type_tag, or_node_tag>)
+      return std::apply(
+        [](auto&&... ns){ return make_parallel(fuse(std::forward<decltype(ns)>(ns))...); },
+        std::forward<Node>(node).get_nodes()
+      );
+    else
+    {
+      auto pieces = detail::fuse_chain<0>(std::forward<Node>(node), std::tuple<>{}, std::tuple<>{});
+      if constexpr (std::tuple_size_v<decltype(pieces)> == 1)
+        return std::get<0>(std::move(pieces));
+      else
+        return std::apply([](auto&&... ns){ return make_chain(std::forward<decltype(ns)>(ns)...); }, std::move(pieces));
+    }
+  }
+
+  namespace detail
+  {
+    template <typename TypeList>
+    struct unfused_node_num_impl;
+    template <typename... Ns>
+    struct unfused_node_num_impl<type_list<Ns...>>: std::integral_constant<std::size_t, (fused_count<Ns>::value + ...)> {};
+  }
+
+  // the number of single nodes of Graph before fuse(), the same as Graph::node_num for a graph without fused_nodes
+  template <typename Graph>
+  struct unfused_node_num: detail::unfused_node_num_impl<flat_nodes_t<Graph>> {};
+  template <typename Graph>
+  constexpr std::size_t unfused_node_num_v = unfused_node_num<Graph>::value;
+}
+
+#endif
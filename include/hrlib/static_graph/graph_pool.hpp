@@ -0,0 +1,156 @@
+#ifndef HRLIB_STATIC_GRAPH_GRAPH_POOL
+#define HRLIB_STATIC_GRAPH_GRAPH_POOL
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    template <typename Node>
+    using reset_member_t = decltype(std::declval<Node&>().reset());
+  }
+
+  // a fixed number of instances of one graph type, copied from a prototype and connected once when the pool is created.
+  // acquire() hands out a free instance and the handle gives it back when it is destroyed, both without locks.
+  // when an instance comes back, every single node which provides reset() is reset, the other nodes are left as they are,
+  // so a node declares its per-run state (e.g. is_visited) by resetting it there. reset() must be noexcept, as it runs in the destructor of a handle.
+  // the instances never move, so their pointer links stay valid. the pool must outlive the handles.
+  template <typename Graph>
+  class graph_pool
+  {
+  public:
+    using graph_type = Graph;
+    class handle
+    {
+      friend class graph_pool;
+      graph_pool* pool = nullptr;
+      Graph* graph = nullptr;
+      handle(graph_pool* pool, Graph* graph): pool(pool), graph(graph) {}
+    public:
+      handle() = default;
+      handle(const handle&) = delete;
+      handle(handle&& other) noexcept: pool(std::exchange(other.pool, nullptr)), graph(std::exchange(other.graph, nullptr)) {}
+      handle& operator=(const handle&) = delete;
+      handle& operator=(handle&& other) noexcept
+      {
+        if (this != &other)
+        {
+          reset();
+          pool = std::exchange(other.pool, nullptr);
+          graph = std::exchange(other.graph, nullptr);
+        }
+        return *this;
+      }
+      ~handle() { reset(); }
+      explicit operator bool() const noexcept { return graph != nullptr; }
+      Graph& operator*() const noexcept { return *graph; }
+      Graph* operator->() const noexcept { return graph; }
+      Graph* get() const noexcept { return graph; }
+      // gives the instance back to the pool
+      void reset()
+      {
+        if (graph != nullptr)
+          pool->release(*graph);
+        pool = nullptr;
+        graph = nullptr;
+      }
+    };
+  private:
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+    // the head of the free list in the low half and a counter in the high half, which is bumped by every change against ABA
+    static constexpr std::uint64_t make_head(std::uint32_t index, std::uint64_t tag) { return (tag << 32) | index; }
+    static constexpr std::uint32_t index_of(std::uint64_t head) { return static_cast<std::uint32_t>(head); }
+    static constexpr std::uint64_t tag_of(std::uint64_t head) { return head >> 32; }
+
+    std::size_t capacity;
+    std::allocator<Graph> allocator;
+    // allocated before graphs, so it is freed when the allocation of graphs throws
+    std::unique_ptr<std::atomic<std::uint32_t>[]> next_free;
+    Graph* graphs;
+    std::atomic<std::uint64_t> head;
+
+    template <std::size_t... Is>
+    static void reset_nodes(Graph& graph, std::index_sequence<Is...>) noexcept
+    {
+      auto reset_node = [](auto& node)
+      {
+        if constexpr (type_traits::is_detected_v<detail::reset_member_t, std::remove_reference_t<decltype(node)>>)
+        {
+          static_assert(noexcept(node.reset()), "reset() of a pooled node must be noexcept");
+          node.reset();
+        }
+      };
+      (reset_node(node_at<Is>(graph)), ...);
+    }
+    void push(std::uint32_t index)
+    {
+      auto current = head.load(std::memory_order_relaxed);
+      do
+        next_free[index].store(index_of(current), std::memory_order_relaxed);
+      while (!head.compare_exchange_weak(current, make_head(index, tag_of(current) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+    void release(Graph& graph)
+    {
+      reset_nodes(graph, std::make_index_sequence<Graph::node_num>{});
+      push(static_cast<std::uint32_t>(&graph - graphs));
+    }
+  public:
+    graph_pool(const Graph& prototype, std::size_t capacity)
+      : capacity(capacity), next_free(new std::atomic<std::uint32_t>[capacity]), graphs(allocator.allocate(capacity)), head(make_head(npos, 0))
+    {
+      // npos marks the end of the free list, so it must not be an index
+      assert(capacity < npos);
+      std::size_t constructed = 0;
+      try
+      {
+        for (; constructed < capacity; ++constructed)
+          ::new (static_cast<void*>(graphs + constructed)) Graph(prototype);
+      }
+      catch (...)
+      {
+        while (constructed-- > 0)
+          graphs[constructed].~Graph();
+        allocator.deallocate(graphs, capacity);
+        throw;
+      }
+      for (auto i = capacity; i-- > 0;)
+      {
+        graphs[i].construct_connection();
+        next_free[i].store(index_of(head.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        head.store(make_head(static_cast<std::uint32_t>(i), 0), std::memory_order_relaxed);
+      }
+    }
+    graph_pool(const graph_pool&) = delete;
+    graph_pool& operator=(const graph_pool&) = delete;
+    ~graph_pool()
+    {
+      for (std::size_t i = 0; i < capacity; ++i)
+        graphs[i].~Graph();
+      allocator.deallocate(graphs, capacity);
+    }
+    std::size_t size() const noexcept { return capacity; }
+    // a free instance, or an empty handle when all instances are in use
+    handle acquire()
+    {
+      auto current = head.load(std::memory_order_acquire);
+      while (index_of(current) != npos)
+      {
+        const auto next = next_free[index_of(current)].load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(current, make_head(next, tag_of(current) + 1), std::memory_order_acquire, std::memory_order_acquire))
+          return handle(this, graphs + index_of(current));
+      }
+      return handle();
+    }
+  };
+}
+
+#endif
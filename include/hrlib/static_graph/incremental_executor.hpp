@@ -0,0 +1,132 @@
+#ifndef HRLIB_STATIC_GRAPH_INCREMENTAL_EXECUTOR
+#define HRLIB_STATIC_GRAPH_INCREMENTAL_EXECUTOR
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    // the index of the lowest set bit, bits must not be 0
+    inline std::size_t count_trailing_zeros(std::uint64_t bits) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long res;
+      _BitScanForward64(&res, bits);
+      return res;
+#else
+      std::size_t res = 0;
+      while (((bits >> res) & 1) == 0)
+        ++res;
+      return res;
+#endif
+    }
+
+    template <typename Node, typename... Ins>
+    using evaluate_result_t = decltype(std::declval<Node&>().evaluate(std::declval<const Ins&>()...));
+
+    template <typename Graph, std::size_t I, typename Seq = predecessors_t<Graph, I>>
+    struct incremental_output;
+    template <typename Graph, std::size_t I, std::size_t... Ps>
+    struct incremental_output<Graph, I, std::index_sequence<Ps...>>
+      : type_traits::identity<std::decay_t<evaluate_result_t<node_at_t<Graph, I>, typename incremental_output<Graph, Ps>::type...>>> {};
+  }
+
+  // re-evaluates only the nodes downstream of changed inputs.
+  // every single node provides evaluate(const Ins&...) -> Out, which gets the cached outputs of its predecessors in increasing index order,
+  // a node without a predecessor provides evaluate() and reads its input from its own state, a node returning void must be a last node.
+  // an executor holds the outputs of the last evaluation and a dirty bitset for one graph instance.
+  // invalidate(i) marks the node i and all nodes reachable from it dirty with the precomputed reachability bitsets,
+  // and run() evaluates only the dirty nodes in topological order. all nodes are dirty at first.
+  template <typename Graph>
+  class incremental_executor
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+    template <std::size_t I>
+    using output_type = typename detail::incremental_output<Graph, I>::type;
+  private:
+    using reachability = detail::reachability_table<Graph>;
+    using bitset_type = typename reachability::bitset_type;
+    template <std::size_t I>
+    using cache_type = std::optional<std::conditional_t<std::is_void_v<output_type<I>>, std::tuple<>, output_type<I>>>;
+    template <typename Seq>
+    struct caches_impl;
+    template <std::size_t... Is>
+    struct caches_impl<std::index_sequence<Is...>>: type_traits::identity<std::tuple<cache_type<Is>...>> {};
+
+    typename caches_impl<std::make_index_sequence<node_num>>::type caches;
+    // zeroed here, invalidate_all() only sets the bits of the nodes
+    bitset_type dirty_nodes{};
+
+    template <std::size_t I, std::size_t... Ps>
+    void evaluate_node(Graph& graph, std::index_sequence<Ps...>)
+    {
+      if constexpr (std::is_void_v<output_type<I>>)
+      {
+        node_at<I>(graph).evaluate(*std::get<Ps>(caches)...);
+        std::get<I>(caches).emplace();
+      }
+      else
+        std::get<I>(caches) = node_at<I>(graph).evaluate(*std::get<Ps>(caches)...);
+    }
+    template <std::size_t I>
+    static void dispatch_node(incremental_executor& executor, Graph& graph) { executor.evaluate_node<I>(graph, predecessors_t<Graph, I>{}); }
+    template <std::size_t... Is>
+    static constexpr std::array<void (*)(incremental_executor&, Graph&), node_num> make_dispatch_table(std::index_sequence<Is...>)
+    {
+      return {{&dispatch_node<Is>...}};
+    }
+    static constexpr auto dispatch_table = make_dispatch_table(std::make_index_sequence<node_num>{});
+  public:
+    incremental_executor() { invalidate_all(); }
+    void invalidate(std::size_t index)
+    {
+      for (std::size_t w = 0; w < reachability::word_num; ++w)
+        dirty_nodes[w] |= reachability::reachable[index][w];
+    }
+    void invalidate_all()
+    {
+      for (std::size_t i = 0; i < node_num; ++i)
+        dirty_nodes[i / reachability::word_bits] |= std::uint64_t{1} << (i % reachability::word_bits);
+    }
+    bool is_dirty(std::size_t index) const { return (dirty_nodes[index / reachability::word_bits] >> (index % reachability::word_bits)) & 1; }
+    // evaluates the dirty nodes, returns the number of evaluated nodes
+    std::size_t run(Graph& graph)
+    {
+      std::size_t evaluated = 0;
+      for (std::size_t w = 0; w < reachability::word_num; ++w)
+        for (auto bits = dirty_nodes[w]; bits != 0; bits &= bits - 1)
+        {
+          dispatch_table[w * reachability::word_bits + detail::count_trailing_zeros(bits)](*this, graph);
+          ++evaluated;
+        }
+      dirty_nodes = bitset_type{};
+      return evaluated;
+    }
+    // the output of the I-th node from the last evaluation
+    template <std::size_t I>
+    const output_type<I>& output() const
+    {
+      static_assert(!std::is_void_v<output_type<I>>);
+      return *std::get<I>(caches);
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef HRLIB_STATIC_GRAPH_INSTRUMENTATION
+#define HRLIB_STATIC_GRAPH_INSTRUMENTATION
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hrlib::static_graph
+{
+  // instrumentation policies of the executors.
+  // an executor calls on_enter(index) before and on_exit(index) after it runs the single node with the flat index index,
+  // flat indices follow the order of the nodes in the graph expression (see flat_nodes_t).
+  // the hooks may be called concurrently from several threads by parallel_executor.
+
+  // the default policy, the hooks are empty and compile to nothing
+  struct no_instrumentation
+  {
+    constexpr void on_enter(std::size_t) const noexcept {}
+    constexpr void on_exit(std::size_t) const noexcept {}
+  };
+
+  struct node_profile
+  {
+    std::uint64_t calls = 0;
+    std::uint64_t nanoseconds = 0;
+  };
+
+  // per node call counts and elapsed times.
+  // every thread records into its own block of cache line sized counters, so recording needs no synchronisation.
+  // a thread remembers its blocks of the last few profilers it has used, only the first record into a profiler (or one after
+  // the thread has used more other profilers since) takes the lock.
+  // snapshot() may be called at any time and sums the blocks of all threads.
+  class node_profiler
+  {
+    static constexpr std::size_t cache_line_size = 64;
+    struct alignas(cache_line_size) counter
+    {
+      // written only by the owner thread, atomic so that snapshot() can read them concurrently
+      std::atomic<std::uint64_t> calls{0};
+      std::atomic<std::uint64_t> nanoseconds{0};
+      std::chrono::steady_clock::time_point start{};
+    };
+    struct thread_block
+    {
+      std::thread::id owner;
+      std::unique_ptr<counter[]> counters;
+      thread_block(std::thread::id owner, std::size_t node_num): owner(owner), counters(new counter[node_num]) {}
+    };
+    struct thread_cache
+    {
+      static constexpr std::size_t size = 8;
+      struct entry
+      {
+        std::uint64_t generation = 0; // 0 is never given to a profiler
+        counter* counters = nullptr;
+      };
+      std::array<entry, size> entries{};
+      std::size_t last = 0; // the entry found last time
+      std::size_t next = 0; // the entry replaced next, round robin
+    };
+    static std::uint64_t next_generation()
+    {
+      static std::atomic<std::uint64_t> generation{0};
+      return ++generation;
+    }
+
+    std::size_t node_num;
+    std::uint64_t generation = next_generation(); // unique among all profilers, also those which reuse the address of a destroyed one
+    mutable std::mutex mutex;
+    mutable std::vector<std::unique_ptr<thread_block>> blocks;
+
+    counter* thread_counters() const
+    {
+      static thread_local thread_cache cache;
+      if (cache.entries[cache.last].generation == generation)
+        return cache.entries[cache.last].counters;
+      for (std::size_t i = 0; i < thread_cache::size; ++i)
+        if (cache.entries[i].generation == generation)
+        {
+          cache.last = i;
+          return cache.entries[i].counters;
+        }
+      // the first record of the thread into this profiler, or its entry has been replaced since
+      const auto id = std::this_thread::get_id();
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = blocks.begin();
+      while (it != blocks.end() && (*it)->owner != id)
+        ++it;
+      if (it == blocks.end())
+        it = blocks.insert(blocks.end(), std::make_unique<thread_block>(id, node_num));
+      cache.last = cache.next;
+      cache.next = (cache.next + 1) % thread_cache::size;
+      cache.entries[cache.last] = {generation, (*it)->counters.get()};
+      return cache.entries[cache.last].counters;
+    }
+  public:
+    explicit node_profiler(std::size_t node_num): node_num(node_num) {}
+    node_profiler(const node_profiler&) = delete;
+    node_profiler& operator=(const node_profiler&) = delete;
+    std::size_t size() const noexcept { return node_num; }
+    void enter(std::size_t index) const { thread_counters()[index].start = std::chrono::steady_clock::now(); }
+    void exit(std::size_t index) const
+    {
+      const auto end = std::chrono::steady_clock::now();
+      auto& c = thread_counters()[index];
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - c.start).count();
+      c.calls.store(c.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      c.nanoseconds.store(c.nanoseconds.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(elapsed), std::memory_order_relaxed);
+    }
+    std::vector<node_profile> snapshot() const
+    {
+      std::vector<node_profile> res(node_num);
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const auto& block: blocks)
+        for (std::size_t i = 0; i < node_num; ++i)
+        {
+          res[i].calls += block->counters[i].calls.load(std::memory_order_relaxed);
+          res[i].nanoseconds += block->counters[i].nanoseconds.load(std::memory_order_relaxed);
+        }
+      return res;
+    }
+  };
+
+  // the policy recording into a node_profiler
+  class profiling_instrumentation
+  {
+    const node_profiler* profiler;
+  public:
+    explicit profiling_instrumentation(const node_profiler& profiler): profiler(&profiler) {}
+    void on_enter(std::size_t index) const { profiler->enter(index); }
+    void on_exit(std::size_t index) const { profiler->exit(index); }
+  };
+}
+
+#endif
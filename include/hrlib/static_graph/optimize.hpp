@@ -0,0 +1,140 @@
+#ifndef HRLIB_STATIC_GRAPH_OPTIMIZE
+#define HRLIB_STATIC_GRAPH_OPTIMIZE
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    template <typename Node>
+    using enabled_member_t = decltype(Node::enabled);
+    template <typename Node, bool = type_traits::is_detected_v<enabled_member_t, Node>>
+    struct node_enabled_impl: std::true_type {};
+    template <typename Node>
+    struct node_enabled_impl<Node, true>: std::bool_constant<static_cast<bool>(Node::enabled)> {};
+
+    template <typename Node>
+    using pure_member_t = decltype(Node::pure);
+    template <typename Node, bool = type_traits::is_detected_v<pure_member_t, Node>>
+    struct node_pure_impl: std::false_type {};
+    template <typename Node>
+    struct node_pure_impl<Node, true>: std::bool_constant<static_cast<bool>(Node::pure)> {};
+  }
+
+  // whether a single node is part of the graph, given by an optional member static constexpr enabled, true by default
+  template <typename Node>
+  struct node_enabled: detail::node_enabled_impl<Node> {};
+  template <typename Node>
+  constexpr bool node_enabled_v = node_enabled<Node>::value;
+
+  // whether a single node does the same as any other node of its type, given by an optional member static constexpr pure, false by default.
+  // running a pure node twice is the same as running it once, e.g. it depends only on its type and writes nothing others read
+  template <typename Node>
+  struct node_pure: detail::node_pure_impl<Node> {};
+  template <typename Node>
+  constexpr bool node_pure_v = node_pure<Node>::value;
+
+  namespace detail
+  {
+    template <typename Node, typename Tag = typename Node::node_type_tag>
+    struct graph_enabled;
+    template <typename Tuple>
+    struct all_enabled;
+    template <typename... Ns>
+    struct all_enabled<std::tuple<Ns...>>: std::bool_constant<(graph_enabled<Ns>::value && ...)> {};
+    template <typename Tuple>
+    struct any_enabled;
+    template <typename... Ns>
+    struct any_enabled<std::tuple<Ns...>>: std::bool_constant<(graph_enabled<Ns>::value || ...)> {};
+
+    // a chain is enabled when all of its elements are, an or_node when any of its branches is
+    template <typename Node, typename Tag>
+    struct graph_enabled: node_enabled<Node> {};
+    template <typename Node>
+    struct graph_enabled<Node, chained_node_tag>: all_enabled<typename Node::content_type> {};
+    template <typename Node>
+    struct graph_enabled<Node, or_node_tag>: any_enabled<typename Node::content_type> {};
+
+    template <typename TypeList>
+    struct all_pure;
+    template <typename... Ns>
+    struct all_pure<type_list<Ns...>>: std::bool_constant<(node_pure<Ns>::value && ...)> {};
+
+    template <typename Node, typename Kept>
+    struct is_duplicate_branch;
+    template <typename Node, typename... Ks>
+    struct is_duplicate_branch<Node, std::tuple<Ks...>>
+      : std::bool_constant<all_pure<flat_nodes_t<Node>>::value && std::disjunction_v<std::is_same<Node, Ks>...>> {};
+  }
+
+  // rewrites a graph into a smaller one with the same behaviour for run(Args&...):
+  //   a single node whose enabled is false is removed with the whole chain it is in, up to the nearest or_node,
+  //   and an or_node whose branches are all removed is removed in the same way,
+  //   of the branches of an or_node which have the same type and consist of pure nodes only the first one is kept,
+  //   an or_node left with one branch becomes that branch, spliced into the enclosing chain.
+  // the graph needs at least one enabled path. the join after a rewritten or_node gets the outputs of the remaining branches only.
+  // as for any copied graph, construct_connection() must be called on the result before it is traversed by its pointer links.
+  template <typename Node>
+  constexpr auto optimize(Node&& node);
+
+  namespace detail
+  {
+    template <typename Node>
+    constexpr auto optimize_impl(Node&& node);
+
+    template <std::size_t I, typename OrNode, typename Kept>
+    constexpr auto optimize_branches(OrNode&& or_node, Kept&& kept)
+    {
+      using content_type = typename std::decay_t<OrNode>::content_type;
+      if constexpr (I == std::tuple_size_v<content_type>)
+        return std::forward<Kept>(kept);
+      else if constexpr (!graph_enabled<std::tuple_element_t<I, content_type>>::value)
+        return optimize_branches<I + 1>(std::forward<OrNode>(or_node), std::forward<Kept>(kept));
+      else
+      {
+        auto branch = optimize_impl(std::get<I>(std::forward<OrNode>(or_node).get_nodes()));
+        if constexpr (is_duplicate_branch<decltype(branch), std::decay_t<Kept>>::value)
+          return optimize_branches<I + 1>(std::forward<OrNode>(or_node), std::forward<Kept>(kept));
+        else
+          return optimize_branches<I + 1>(std::forward<OrNode>(or_node), std::tuple_cat(std::forward<Kept>(kept), std::make_tuple(std::move(branch))));
+      }
+    }
+
+    template <typename Node>
+    constexpr auto optimize_impl(Node&& node)
+    {
+      using NodeType = std::decay_t<Node>;
+      if constexpr (std::is_same_v<typename NodeType::node_type_tag, single_node_tag>)
+        return NodeType(std::forward<Node>(node));
+      else if constexpr (std::is_same_v<typename NodeType::node_type_tag, or_node_tag>)
+      {
+        auto branches = optimize_branches<0>(std::forward<Node>(node), std::tuple<>{});
+        if constexpr (std::tuple_size_v<decltype(branches)> == 1)
+          return std::get<0>(std::move(branches));
+        else
+          return std::apply([](auto&&... ns){ return make_parallel(std::forward<decltype(ns)>(ns)...); }, std::move(branches));
+      }
+      else
+        // every element of an enabled chain is enabled
+        return std::apply(
+          [](auto&&... ns){ return make_chain(optimize_impl(std::forward<decltype(ns)>(ns))...); },
+          std::forward<Node>(node).get_nodes()
+        );
+    }
+  }
+
+  template <typename Node>
+  constexpr auto optimize(Node&& node)
+  {
+    static_assert(detail::graph_enabled<std::decay_t<Node>>::value, "optimize() needs a graph with at least one enabled path");
+    return detail::optimize_impl(std::forward<Node>(node));
+  }
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef HRLIB_STATIC_GRAPH_PARALLEL_EXECUTOR
+#define HRLIB_STATIC_GRAPH_PARALLEL_EXECUTOR
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/work_stealing_pool.hpp>
+#include <hrlib/static_graph/instrumentation.hpp>
+
+namespace hrlib::static_graph
+{
+  // runs the single nodes of a graph concurrently on a work_stealing_pool.
+  // every node has a join counter initialised with its number of predecessors, which is known at compile time,
+  // and the node which brings the counter of a successor to zero schedules that successor.
+  // so the branches of an or_node run in parallel and the node after the or_node starts when all of them have finished.
+  // a finished node continues with one of its ready successors on the same thread and pushes the others to the pool.
+  // the calling thread helps to run the graph until all nodes have finished.
+  // run(Args&...) of different nodes is called concurrently with the same arguments, and it must not throw.
+  // Instrumentation is called around every node on the thread which runs the node, see instrumentation.hpp.
+  template <typename Graph, typename Instrumentation = no_instrumentation>
+  class parallel_executor
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    using table = detail::successor_table<Graph>;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    template <typename... Args>
+    struct run_state
+    {
+      Graph& graph;
+      std::tuple<Args&...> args;
+      work_stealing_pool& pool;
+      const Instrumentation& instrumentation;
+      std::array<std::atomic<std::size_t>, node_num> join_counters;
+      std::atomic<std::size_t> remaining;
+      run_state(Graph& graph, std::tuple<Args&...> args, work_stealing_pool& pool, const Instrumentation& instrumentation)
+        : graph(graph), args(args), pool(pool), instrumentation(instrumentation), remaining(node_num)
+      {
+        for (std::size_t i = 0; i < node_num; ++i)
+          join_counters[i].store(table::predecessor_counts[i], std::memory_order_relaxed);
+      }
+    };
+
+    template <typename State, std::size_t I>
+    static void run_node(State& state)
+    {
+      std::apply([&state](auto&... args){ node_at<I>(state.graph).run(args...); }, state.args);
+    }
+    template <typename State, std::size_t... Is>
+    static constexpr std::array<void (*)(State&), node_num> make_dispatch_table(std::index_sequence<Is...>)
+    {
+      return {{&run_node<State, Is>...}};
+    }
+    template <typename State>
+    static constexpr auto dispatch_table = make_dispatch_table<State>(std::make_index_sequence<node_num>{});
+
+    template <typename State>
+    static void execute(void* context, std::size_t index)
+    {
+      auto& state = *static_cast<State*>(context);
+      while (index != npos)
+      {
+        state.instrumentation.on_enter(index);
+        dispatch_table<State>[index](state);
+        state.instrumentation.on_exit(index);
+        auto next = npos;
+        for (auto i = table::successor_offsets[index]; i < table::successor_offsets[index + 1]; ++i)
+        {
+          const auto successor = table::successors[i];
+          // a node with only one predecessor is ready as soon as that predecessor has finished, its counter is never touched
+          if (table::predecessor_counts[successor] != 1 && state.join_counters[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+            continue;
+          if (next == npos)
+            next = successor;
+          else
+            state.pool.push({&execute<State>, context, successor});
+        }
+        // the state must not be touched after the last node has finished
+        state.remaining.fetch_sub(1, std::memory_order_acq_rel);
+        index = next;
+      }
+    }
+
+    work_stealing_pool* pool;
+    Instrumentation instrumentation;
+  public:
+    explicit parallel_executor(work_stealing_pool& pool, const Instrumentation& instrumentation = Instrumentation()): pool(&pool), instrumentation(instrumentation) {}
+    template <typename... Args>
+    void run(Graph& graph, Args&&... args) const
+    {
+      using state_type = run_state<std::remove_reference_t<Args>...>;
+      state_type state(graph, std::tie(args...), *pool, instrumentation);
+      auto first = npos;
+      for (std::size_t i = 0; i < node_num; ++i)
+      {
+        if (table::predecessor_counts[i] != 0)
+          continue;
+        if (first == npos)
+          first = i;
+        else
+          pool->push({&execute<state_type>, &state, i});
+      }
+      execute<state_type>(&state, first);
+      while (state.remaining.load(std::memory_order_acquire) != 0)
+        if (!pool->run_one())
+          std::this_thread::yield();
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef HRLIB_STATIC_GRAPH_PIPELINE_EXECUTOR
+#define HRLIB_STATIC_GRAPH_PIPELINE_EXECUTOR
+
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/spsc_ring.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    template <std::size_t>
+    inline constexpr std::size_t one = 1;
+    template <typename Seq>
+    struct single_stage_groups_impl;
+    template <std::size_t... Is>
+    struct single_stage_groups_impl<std::index_sequence<Is...>>: type_traits::identity<std::index_sequence<one<Is>...>> {};
+    template <std::size_t N>
+    using single_stage_groups = typename single_stage_groups_impl<std::make_index_sequence<N>>::type;
+
+    // the type of the records the K-th stage of a chained_node receives
+    template <typename Graph, typename In, std::size_t K>
+    struct pipeline_stage_input
+      : type_traits::identity<
+          dataflow_result_t<
+            std::tuple_element_t<K - 1, typename Graph::content_type>,
+            typename pipeline_stage_input<Graph, In, K - 1>::type&&
+          >
+        > {};
+    template <typename Graph, typename In>
+    struct pipeline_stage_input<Graph, In, 0>: type_traits::identity<In> {};
+  }
+
+  // counters of a group of stages, valid after run() has returned.
+  // the depth of the input ring is sampled every time the group takes a record, from the consumer's cached tail so that the sample
+  // costs no read of the producer's index. it is exact when the group has just found its ring empty and a lower bound otherwise.
+  // a bottleneck group has a deep input ring and its predecessor often waits for room in that ring (full_waits of the predecessor),
+  // a starved group often finds its input ring empty (empty_waits).
+  struct pipeline_stage_stats
+  {
+    std::size_t processed = 0;
+    std::size_t depth_sum = 0;
+    std::size_t max_depth = 0;
+    std::size_t full_waits = 0; // waits for room in the input ring of the next group
+    std::size_t empty_waits = 0;
+    double average_depth() const noexcept { return processed == 0 ? 0.0 : static_cast<double>(depth_sum) / processed; }
+  };
+
+  // runs the stages of a chained_node (the elements of its content_type) as a pipeline of threads.
+  // the stages are split into groups of consecutive stages, Groups is the sequence of the group sizes (one stage per group by default).
+  // every group runs on its own thread and processes its stages in dataflow mode (see dataflow.hpp),
+  // the groups are connected by bounded spsc_rings, so the throughput is bounded by the slowest group.
+  // the calling thread feeds the records into the first ring and the sink is called on the thread of the last group.
+  // process() of the nodes must not throw.
+  template <typename Graph, typename In, typename Groups = detail::single_stage_groups<Graph::chain_size>>
+  class pipeline_executor
+  {
+    static_assert(std::is_same_v<typename Graph::node_type_tag, chained_node_tag>, "pipeline_executor runs the stages of a chained_node");
+    static_assert(is_dataflow_graph_v<Graph, In>, "the output type of a node does not match the input type of its successor");
+  public:
+    using graph_type = Graph;
+    using input_type = In;
+    static constexpr std::size_t stage_num = Graph::chain_size;
+    static constexpr std::size_t group_num = Groups::size();
+    template <std::size_t K>
+    using stage_type = std::tuple_element_t<K, typename Graph::content_type>;
+    template <std::size_t K>
+    using stage_input_type = typename detail::pipeline_stage_input<Graph, In, K>::type;
+  private:
+    template <std::size_t... Ns>
+    static constexpr auto make_group_offsets(std::index_sequence<Ns...>)
+    {
+      constexpr std::size_t sizes[] = {Ns...};
+      std::array<std::size_t, sizeof...(Ns) + 1> res{};
+      for (std::size_t i = 0; i < sizeof...(Ns); ++i)
+        res[i + 1] = res[i] + sizes[i];
+      return res;
+    }
+    static constexpr auto group_offsets = make_group_offsets(Groups{});
+    static_assert(group_num > 0 && group_offsets[group_num] == stage_num, "the group sizes must add up to the number of stages");
+
+    template <typename Seq>
+    struct rings_impl;
+    template <std::size_t... Gs>
+    struct rings_impl<std::index_sequence<Gs...>>
+    {
+      using type = std::tuple<spsc_ring<stage_input_type<group_offsets[Gs]>>...>; // the input ring of every group
+      static type make(std::size_t capacity) { return type(((void)Gs, capacity)...); }
+    };
+    using rings_type = typename rings_impl<std::make_index_sequence<group_num>>::type;
+
+    std::size_t ring_capacity;
+    // every group counts into its own stats on its thread and stores them here when it finishes
+    std::array<pipeline_stage_stats, group_num> group_stats{};
+    std::size_t feed_full_waits = 0;
+
+    template <typename Ring, typename T>
+    static void push_blocking(Ring& ring, T&& record, std::size_t& full_waits)
+    {
+      while (!ring.try_push(std::forward<T>(record)))
+      {
+        ++full_waits;
+        std::this_thread::yield();
+      }
+    }
+    template <std::size_t G, std::size_t K, typename T, typename Sink>
+    static void push_stages(Graph& graph, T&& record, rings_type& rings, Sink& sink, pipeline_stage_stats& stats)
+    {
+      if constexpr (K == group_offsets[G + 1])
+      {
+        if constexpr (G + 1 == group_num)
+          sink(std::forward<T>(record));
+        else
+          push_blocking(std::get<G + 1>(rings), std::forward<T>(record), stats.full_waits);
+      }
+      else
+        dataflow_executor<stage_type<K>>{}.push(
+          std::get<K>(graph.get_nodes()),
+          std::forward<T>(record),
+          [&graph, &rings, &sink, &stats](auto&& out){ push_stages<G, K + 1>(graph, std::forward<decltype(out)>(out), rings, sink, stats); }
+        );
+    }
+    template <std::size_t G, typename Sink>
+    void run_group(Graph& graph, rings_type& rings, Sink& sink)
+    {
+      auto& in = std::get<G>(rings);
+      pipeline_stage_stats stats;
+      while (true)
+      {
+        if (in.try_consume([&graph, &rings, &sink, &stats](auto&& record){ push_stages<G, group_offsets[G]>(graph, std::move(record), rings, sink, stats); }))
+        {
+          // the record just taken and the ones known behind it
+          const auto depth = in.known_size() + 1;
+          ++stats.processed;
+          stats.depth_sum += depth;
+          stats.max_depth = std::max(stats.max_depth, depth);
+        }
+        else if (in.is_drained())
+          break;
+        else
+        {
+          ++stats.empty_waits;
+          std::this_thread::yield();
+        }
+      }
+      if constexpr (G + 1 < group_num)
+        std::get<G + 1>(rings).close();
+      group_stats[G] = stats; // published to run() by join()
+    }
+    // closing the first ring lets every started group drain the records pushed so far and finish
+    static void stop_groups(rings_type& rings, std::array<std::thread, group_num>& threads)
+    {
+      std::get<0>(rings).close();
+      for (auto& thread: threads)
+        if (thread.joinable())
+          thread.join();
+    }
+    template <typename Sink, std::size_t... Gs>
+    void start_groups(Graph& graph, rings_type& rings, Sink& sink, std::array<std::thread, group_num>& threads, std::index_sequence<Gs...>)
+    {
+      try
+      {
+        ((threads[Gs] = std::thread([this, &graph, &rings, &sink]{ run_group<Gs>(graph, rings, sink); })), ...);
+      }
+      catch (...)
+      {
+        stop_groups(rings, threads);
+        throw;
+      }
+    }
+  public:
+    explicit pipeline_executor(std::size_t ring_capacity = 1024): ring_capacity(ring_capacity) {}
+    const std::array<pipeline_stage_stats, group_num>& stats() const noexcept { return group_stats; }
+    // how often the calling thread waited for room in the input ring of the first group
+    std::size_t input_full_waits() const noexcept { return feed_full_waits; }
+    // streams every record of the range through the pipeline and returns when the last group has finished.
+    // when iterating the range throws, the records pushed so far are still processed before the exception is rethrown
+    template <typename Range, typename Sink>
+    void run(Graph& graph, Range&& records, Sink&& sink)
+    {
+      group_stats = {};
+      feed_full_waits = 0;
+      auto rings = rings_impl<std::make_index_sequence<group_num>>::make(ring_capacity);
+      std::array<std::thread, group_num> threads;
+      start_groups(graph, rings, sink, threads, std::make_index_sequence<group_num>{});
+      std::size_t full_waits = 0;
+      try
+      {
+        for (auto&& record: records)
+          push_blocking(std::get<0>(rings), std::forward<decltype(record)>(record), full_waits);
+      }
+      catch (...)
+      {
+        stop_groups(rings, threads);
+        throw;
+      }
+      stop_groups(rings, threads);
+      feed_full_waits = full_waits;
+    }
+    template <typename Range>
+    void run(Graph& graph, Range&& records) { run(graph, std::forward<Range>(records), detail::discard_sink{}); }
+  };
+}
+
+#endif
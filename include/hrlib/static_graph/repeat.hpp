@@ -0,0 +1,111 @@
+#ifndef HRLIB_STATIC_GRAPH_REPEAT
+#define HRLIB_STATIC_GRAPH_REPEAT
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+
+namespace hrlib::static_graph
+{
+  // single nodes which execute a subgraph several times, so an iterative step is written once instead of unrolled into a long chain.
+  // the subgraph is held in place and reused by every iteration, construct_connection() wires its links once.
+  // in the enclosing graph a repeat node is one single node (node_num is 1), the subgraph is reached with get_subgraph().
+  //   run(Args&...): runs every node of the subgraph in topological order (see flat_executor), once per iteration.
+  //   process(In) -> In: passes the value through the subgraph, once per iteration, and returns the last output.
+  //                      the subgraph must be a single path whose output type is the decayed input type.
+  namespace detail
+  {
+    template <typename Subgraph, typename... Args>
+    constexpr void repeat_run(Subgraph& subgraph, Args&... args) { flat_executor<Subgraph>{}.run(subgraph, args...); }
+
+    template <typename Subgraph, typename T>
+    constexpr void repeat_process(Subgraph& subgraph, T& value)
+    {
+      static_assert(path_count_v<Subgraph> == 1, "process() of a repeat node needs a subgraph with one path");
+      static_assert(std::is_same_v<dataflow_result_t<Subgraph, T&&>, T>, "the output of the subgraph must have the type of its input");
+      // the value has been consumed by the subgraph when the sink is called
+      dataflow_executor<Subgraph>{}.push(subgraph, std::move(value), [&value](auto&& out){ value = std::forward<decltype(out)>(out); });
+    }
+  }
+
+  // runs the subgraph Count times
+  template <typename Next, typename Subgraph, std::size_t Count>
+  struct repeat_node: single_node_base<Next>
+  {
+    using base_type = single_node_base<Next>;
+    using subgraph_type = Subgraph;
+    static constexpr std::size_t repeat_count = Count;
+    Subgraph subgraph;
+    constexpr explicit repeat_node(const Subgraph& subgraph): base_type(), subgraph(subgraph) {}
+    constexpr explicit repeat_node(Subgraph&& subgraph): base_type(), subgraph(std::move(subgraph)) {}
+    template <typename NextNodeType>
+    constexpr repeat_node<NextNodeType, Subgraph, Count> copy() const { return repeat_node<NextNodeType, Subgraph, Count>(subgraph); }
+    template <typename NextNodeType>
+    constexpr repeat_node<NextNodeType, Subgraph, Count> rebind() && { return repeat_node<NextNodeType, Subgraph, Count>(std::move(subgraph)); }
+    constexpr Subgraph& get_subgraph() & { return subgraph; }
+    constexpr const Subgraph& get_subgraph() const & { return subgraph; }
+    constexpr void construct_connection() { subgraph.construct_connection(); }
+    template <typename... Args>
+    constexpr void run(Args&... args)
+    {
+      for (std::size_t i = 0; i < Count; ++i)
+        detail::repeat_run(subgraph, args...);
+    }
+    template <typename In>
+    constexpr std::decay_t<In> process(In&& in)
+    {
+      std::decay_t<In> value(std::forward<In>(in));
+      for (std::size_t i = 0; i < Count; ++i)
+        detail::repeat_process(subgraph, value);
+      return value;
+    }
+  };
+
+  // runs the subgraph as long as the predicate holds, checked before every iteration.
+  // the predicate gets the arguments of run() or the current value of process() by const reference.
+  template <typename Next, typename Pred, typename Subgraph>
+  struct repeat_while_node: single_node_base<Next>
+  {
+    using base_type = single_node_base<Next>;
+    using subgraph_type = Subgraph;
+    Pred pred;
+    Subgraph subgraph;
+    template <typename P, typename S>
+    constexpr repeat_while_node(P&& pred, S&& subgraph): base_type(), pred(std::forward<P>(pred)), subgraph(std::forward<S>(subgraph)) {}
+    template <typename NextNodeType>
+    constexpr repeat_while_node<NextNodeType, Pred, Subgraph> copy() const { return repeat_while_node<NextNodeType, Pred, Subgraph>(pred, subgraph); }
+    template <typename NextNodeType>
+    constexpr repeat_while_node<NextNodeType, Pred, Subgraph> rebind() && { return repeat_while_node<NextNodeType, Pred, Subgraph>(std::move(pred), std::move(subgraph)); }
+    constexpr Subgraph& get_subgraph() & { return subgraph; }
+    constexpr const Subgraph& get_subgraph() const & { return subgraph; }
+    constexpr void construct_connection() { subgraph.construct_connection(); }
+    template <typename... Args>
+    constexpr void run(Args&... args)
+    {
+      while (pred(std::as_const(args)...))
+        detail::repeat_run(subgraph, args...);
+    }
+    template <typename In>
+    constexpr std::decay_t<In> process(In&& in)
+    {
+      std::decay_t<In> value(std::forward<In>(in));
+      while (pred(std::as_const(value)))
+        detail::repeat_process(subgraph, value);
+      return value;
+    }
+  };
+
+  template <std::size_t Count, typename Subgraph>
+  constexpr auto repeat(Subgraph&& subgraph) { return repeat_node<terminal_node, std::decay_t<Subgraph>, Count>(std::forward<Subgraph>(subgraph)); }
+  template <typename Pred, typename Subgraph>
+  constexpr auto repeat_while(Pred&& pred, Subgraph&& subgraph)
+  {
+    return repeat_while_node<terminal_node, std::decay_t<Pred>, std::decay_t<Subgraph>>(std::forward<Pred>(pred), std::forward<Subgraph>(subgraph));
+  }
+}
+
+#endif
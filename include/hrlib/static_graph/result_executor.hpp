@@ -0,0 +1,177 @@
+#ifndef HRLIB_STATIC_GRAPH_RESULT_EXECUTOR
+#define HRLIB_STATIC_GRAPH_RESULT_EXECUTOR
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/error_handling/result.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+
+namespace hrlib::static_graph
+{
+  // dataflow mode with short-circuit on error, every single node provides process(In) -> error_handling::Result<Out, E>.
+  // a record pushed into a graph is passed to the head nodes (by const reference if there are several of them),
+  // and the ok value of a node is passed to its successors, by move for one successor and by const reference for several.
+  // a node after an or_node runs once with the results of all branches merged by result::sequence<MergePolicy>,
+  // so with result::DefaultMergePolicy it gets a result::MergeResult of the ok values of the branches.
+  // when the result of the predecessors is an error the node is not called and its result is that error,
+  // converted to the error type of the node, so a failure skips everything downstream without any exception.
+  // the results of the last nodes are passed to the sink.
+  namespace detail
+  {
+    template <typename Graph, std::size_t I, typename T>
+    using result_passed_t = std::conditional_t<
+      (successors_t<Graph, I>::size() > 1),
+      std::add_lvalue_reference_t<std::add_const_t<T>>,
+      std::add_rvalue_reference_t<T>
+    >;
+
+    template <typename Graph, typename In, typename MergePolicy, std::size_t I, typename Seq = predecessors_t<Graph, I>>
+    struct result_node_traits;
+
+    // OkIn is the type the node is called with, ErrIn the type of the error of the predecessors (void for a head node)
+    template <typename Graph, std::size_t I, typename OkIn, typename ErrIn>
+    struct result_node_traits_base
+    {
+      using ok_input_type = OkIn;
+      using error_input_type = ErrIn;
+      using result_type = std::decay_t<process_result_t<node_at_t<Graph, I>, OkIn>>;
+      static_assert(error_handling::result::is_result_type_v<result_type>, "a node must return error_handling::Result");
+      using ok_type = typename result_type::ok_wrap_type;
+      using error_type = typename result_type::error_wrap_type;
+      static_assert(std::is_void_v<ErrIn> || std::is_constructible_v<error_type, ErrIn>, "the error of the predecessors must be convertible to the error type of the node");
+    };
+
+    // a head node, gets the record
+    template <typename Graph, typename In, typename MergePolicy, std::size_t I>
+    struct result_node_traits<Graph, In, MergePolicy, I, std::index_sequence<>>
+      : result_node_traits_base<
+          Graph, I,
+          std::conditional_t<(head_indices_t<Graph>::size() > 1), std::add_lvalue_reference_t<std::add_const_t<std::remove_reference_t<In>>>, In>,
+          void
+        > {};
+
+    template <typename Graph, typename In, typename MergePolicy, std::size_t I, std::size_t P>
+    struct result_node_traits<Graph, In, MergePolicy, I, std::index_sequence<P>>
+      : result_node_traits_base<
+          Graph, I,
+          result_passed_t<Graph, P, typename result_node_traits<Graph, In, MergePolicy, P>::ok_type>,
+          result_passed_t<Graph, P, typename result_node_traits<Graph, In, MergePolicy, P>::error_type>
+        > {};
+
+    template <typename MergePolicy, typename... Results>
+    using merged_result_t = std::decay_t<decltype(error_handling::result::sequence<MergePolicy>(std::declval<std::tuple<Results...>>()))>;
+
+    // a node after an or_node, gets the merged results of the branches
+    template <typename Graph, typename In, typename MergePolicy, std::size_t I, std::size_t P1, std::size_t P2, std::size_t... Ps>
+    struct result_node_traits<Graph, In, MergePolicy, I, std::index_sequence<P1, P2, Ps...>>
+      : result_node_traits_base<
+          Graph, I,
+          typename merged_result_t<MergePolicy, typename result_node_traits<Graph, In, MergePolicy, P1>::result_type, typename result_node_traits<Graph, In, MergePolicy, P2>::result_type, typename result_node_traits<Graph, In, MergePolicy, Ps>::result_type...>::ok_wrap_type&&,
+          typename merged_result_t<MergePolicy, typename result_node_traits<Graph, In, MergePolicy, P1>::result_type, typename result_node_traits<Graph, In, MergePolicy, P2>::result_type, typename result_node_traits<Graph, In, MergePolicy, Ps>::result_type...>::error_wrap_type&&
+        > {
+      using merged_type = merged_result_t<MergePolicy, typename result_node_traits<Graph, In, MergePolicy, P1>::result_type, typename result_node_traits<Graph, In, MergePolicy, P2>::result_type, typename result_node_traits<Graph, In, MergePolicy, Ps>::result_type...>;
+    };
+  }
+
+  // the result type the I-th node passes on when a record of type In is pushed
+  template <typename Graph, typename In, std::size_t I, typename MergePolicy = error_handling::result::DefaultMergePolicy>
+  using node_result_t = typename detail::result_node_traits<Graph, In, MergePolicy, I>::result_type;
+
+  template <typename Graph, typename MergePolicy = error_handling::result::DefaultMergePolicy>
+  class result_executor
+  {
+  public:
+    using graph_type = Graph;
+    using merge_policy = MergePolicy;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    template <typename In, std::size_t I>
+    using traits = detail::result_node_traits<Graph, In, MergePolicy, I>;
+    template <typename In, typename Seq>
+    struct results_impl;
+    template <typename In, std::size_t... Is>
+    struct results_impl<In, std::index_sequence<Is...>>: type_traits::identity<std::tuple<std::optional<typename traits<In, Is>::result_type>...>> {};
+    template <typename In>
+    using results_type = typename results_impl<In, std::make_index_sequence<node_num>>::type;
+
+    template <std::size_t P, typename T>
+    static detail::result_passed_t<Graph, P, T> pass(T& value) { return static_cast<detail::result_passed_t<Graph, P, T>>(value); }
+    template <typename In, std::size_t I, typename Error>
+    static typename traits<In, I>::result_type make_error(Error&& error)
+    {
+      using result_type = typename traits<In, I>::result_type;
+      return result_type(typename result_type::Err(typename traits<In, I>::error_type(std::forward<Error>(error))));
+    }
+
+    template <typename In, std::size_t I, std::size_t... Ps>
+    static void process_node(Graph& graph, In&& record, results_type<In&&>& results, std::index_sequence<Ps...>)
+    {
+      using node_traits = traits<In&&, I>;
+      auto& result = std::get<I>(results);
+      if constexpr (sizeof...(Ps) == 0)
+        result.emplace(node_at<I>(graph).process(static_cast<typename node_traits::ok_input_type>(record)));
+      else if constexpr (sizeof...(Ps) == 1)
+      {
+        constexpr std::size_t P = (Ps + ...);
+        auto& predecessor = *std::get<P>(results);
+        if (predecessor)
+          result.emplace(node_at<I>(graph).process(pass<P>(predecessor.get_ok())));
+        else
+          result.emplace(make_error<In&&, I>(pass<P>(predecessor.get_err())));
+      }
+      else
+      {
+        using merged_type = typename node_traits::merged_type;
+        merged_type merged = error_handling::result::sequence<MergePolicy>(
+          std::tuple<typename traits<In&&, Ps>::result_type...>(pass<Ps>(*std::get<Ps>(results))...)
+        );
+        if (merged)
+          result.emplace(node_at<I>(graph).process(std::move(merged).get_ok()));
+        else
+          result.emplace(make_error<In&&, I>(std::move(merged).get_err()));
+      }
+    }
+    template <typename In, std::size_t... Is>
+    static void process_nodes(Graph& graph, In&& record, results_type<In&&>& results, std::index_sequence<Is...>)
+    {
+      // the flat index order is a topological order
+      (process_node<In, Is>(graph, std::forward<In>(record), results, predecessors_t<Graph, Is>{}), ...);
+    }
+    template <std::size_t I, typename Results, typename Sink>
+    static void pass_to_sink(Results& results, Sink& sink)
+    {
+      if constexpr (successors_t<Graph, I>::size() == 0)
+        sink(std::move(*std::get<I>(results)));
+    }
+    template <typename Results, typename Sink, std::size_t... Is>
+    static void pass_to_sink(Results& results, Sink& sink, std::index_sequence<Is...>) { (pass_to_sink<Is>(results, sink), ...); }
+  public:
+    result_executor() = default;
+    template <typename T, typename Sink>
+    void push(Graph& graph, T&& record, Sink&& sink) const
+    {
+      results_type<T&&> results;
+      process_nodes<T>(graph, std::forward<T>(record), results, std::make_index_sequence<node_num>{});
+      pass_to_sink(results, sink, std::make_index_sequence<node_num>{});
+    }
+    template <typename T>
+    void push(Graph& graph, T&& record) const { push(graph, std::forward<T>(record), detail::discard_sink{}); }
+    // streams every record of the range through the graph
+    template <typename Range, typename Sink>
+    void run(Graph& graph, Range&& records, Sink&& sink) const
+    {
+      for (auto&& record: records)
+        push(graph, std::forward<decltype(record)>(record), sink);
+    }
+    template <typename Range>
+    void run(Graph& graph, Range&& records) const { run(graph, std::forward<Range>(records), detail::discard_sink{}); }
+  };
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef HRLIB_STATIC_GRAPH_RUNTIME_GRAPH
+#define HRLIB_STATIC_GRAPH_RUNTIME_GRAPH
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  // a graph whose topology is composed at runtime, e.g. from a configuration file, from the same single nodes as a static graph.
+  // runtime_arena<Args...>::make(node) turns a single node or a whole static graph into a runtime_graph,
+  // and runtime_graphs are composed with + and | as static graphs are.
+  // the nodes are constructed in the blocks of the arena one after another, the edges are flat node indices,
+  // and running a graph makes one virtual call run(Args&...) per node, in the same topological order as flat_executor.
+  template <typename... Args>
+  class runtime_node
+  {
+  public:
+    virtual ~runtime_node() = default;
+    virtual void run(Args&... args) = 0;
+  };
+
+  namespace detail
+  {
+    template <typename Node, typename... Args>
+    class runtime_node_holder final: public runtime_node<Args...>
+    {
+      Node node;
+    public:
+      template <typename N>
+      explicit runtime_node_holder(N&& node): node(std::forward<N>(node)) {}
+      void run(Args&... args) override { node.run(args...); }
+    };
+  }
+
+  template <typename... Args>
+  class runtime_graph;
+
+  // owns the nodes of runtime graphs, a node lives until the arena is destroyed
+  template <typename... Args>
+  class runtime_arena
+  {
+    std::size_t block_size;
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    unsigned char* current = nullptr;
+    std::size_t remaining = 0;
+    std::vector<runtime_node<Args...>*> nodes;
+
+    static std::size_t padding(const unsigned char* ptr, std::size_t align) { return (align - reinterpret_cast<std::uintptr_t>(ptr) % align) % align; }
+    void* allocate(std::size_t size, std::size_t align)
+    {
+      if (current == nullptr || padding(current, align) + size > remaining)
+      {
+        const auto new_size = size + align > block_size ? size + align : block_size;
+        blocks.push_back(std::make_unique<unsigned char[]>(new_size));
+        current = blocks.back().get();
+        remaining = new_size;
+      }
+      const auto pad = padding(current, align);
+      auto ptr = current + pad;
+      current += pad + size;
+      remaining -= pad + size;
+      return ptr;
+    }
+    template <typename Node>
+    runtime_node<Args...>* create(Node&& node)
+    {
+      static_assert(single_node_constraints_v<std::decay_t<Node>>);
+      using holder_type = detail::runtime_node_holder<std::decay_t<Node>, Args...>;
+      // reserved first so that push_back cannot throw after the node is constructed
+      if (nodes.size() == nodes.capacity())
+        nodes.reserve(2 * nodes.size() + 1);
+      auto res = ::new (allocate(sizeof(holder_type), alignof(holder_type))) holder_type(std::forward<Node>(node));
+      nodes.push_back(res);
+      return res;
+    }
+    template <typename Graph, std::size_t... Is>
+    runtime_graph<Args...> make_impl(Graph&& graph, std::index_sequence<Is...>);
+  public:
+    explicit runtime_arena(std::size_t block_size = 16 * 1024): block_size(block_size) {}
+    runtime_arena(const runtime_arena&) = delete;
+    runtime_arena& operator=(const runtime_arena&) = delete;
+    ~runtime_arena()
+    {
+      for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+        (*it)->~runtime_node();
+    }
+    std::size_t node_num() const noexcept { return nodes.size(); }
+    std::size_t block_num() const noexcept { return blocks.size(); }
+    // copies or moves the single nodes of a static graph (or one single node) into the arena
+    template <typename Graph>
+    runtime_graph<Args...> make(Graph&& graph)
+    {
+      return make_impl(std::forward<Graph>(graph), std::make_index_sequence<std::decay_t<Graph>::node_num>{});
+    }
+  };
+
+  template <typename... Args>
+  class runtime_graph
+  {
+    friend class runtime_arena<Args...>;
+    runtime_arena<Args...>* arena;
+    std::vector<runtime_node<Args...>*> nodes;
+    std::vector<std::size_t> heads;
+    std::vector<std::size_t> lasts;
+    std::vector<edge> edges;
+
+    explicit runtime_graph(runtime_arena<Args...>& arena): arena(&arena) {}
+    void append(runtime_graph&& other)
+    {
+      assert(arena == other.arena);
+      const auto offset = nodes.size();
+      nodes.insert(nodes.end(), other.nodes.begin(), other.nodes.end());
+      for (auto e: other.edges)
+        edges.push_back(edge{e.from + offset, e.to + offset});
+      for (auto& head: other.heads)
+        head += offset;
+      for (auto& last: other.lasts)
+        last += offset;
+    }
+  public:
+    runtime_graph(const runtime_graph&) = delete;
+    runtime_graph(runtime_graph&&) = default;
+    runtime_graph& operator=(const runtime_graph&) = delete;
+    runtime_graph& operator=(runtime_graph&&) = default;
+    ~runtime_graph() = default;
+
+    std::size_t node_num() const noexcept { return nodes.size(); }
+    const std::vector<std::size_t>& get_heads() const noexcept { return heads; }
+    const std::vector<std::size_t>& get_lasts() const noexcept { return lasts; }
+    const std::vector<edge>& get_edges() const noexcept { return edges; }
+    // every edge goes from a smaller index to a larger one as in a static graph, so the index order is a topological order
+    void run(Args&... args) const
+    {
+      for (auto node: nodes)
+        node->run(args...);
+    }
+
+    friend runtime_graph operator+(runtime_graph lhs, runtime_graph rhs)
+    {
+      const auto offset = lhs.nodes.size();
+      for (auto last: lhs.lasts)
+        for (auto head: rhs.heads)
+          lhs.edges.push_back(edge{last, head + offset});
+      lhs.append(std::move(rhs));
+      lhs.lasts = std::move(rhs.lasts);
+      return lhs;
+    }
+    friend runtime_graph operator|(runtime_graph lhs, runtime_graph rhs)
+    {
+      lhs.append(std::move(rhs));
+      lhs.heads.insert(lhs.heads.end(), rhs.heads.begin(), rhs.heads.end());
+      lhs.lasts.insert(lhs.lasts.end(), rhs.lasts.begin(), rhs.lasts.end());
+      return lhs;
+    }
+  };
+
+  template <typename... Args>
+  template <typename Graph, std::size_t... Is>
+  runtime_graph<Args...> runtime_arena<Args...>::make_impl(Graph&& graph, std::index_sequence<Is...>)
+  {
+    using graph_type = std::decay_t<Graph>;
+    using adj = adjacency<graph_type>;
+    runtime_graph<Args...> res(*this);
+    res.nodes.reserve(sizeof...(Is));
+    if constexpr (std::is_lvalue_reference_v<Graph>)
+      (res.nodes.push_back(create(node_at<Is>(graph))), ...);
+    else
+      (res.nodes.push_back(create(std::move(node_at<Is>(graph)))), ...);
+    for (std::size_t i = 0; i < sizeof...(Is); ++i)
+    {
+      if (adj::in_degree[i] == 0)
+        res.heads.push_back(i);
+      if (adj::out_degree[i] == 0)
+        res.lasts.push_back(i);
+      for (auto successor: adj::successors_of(i))
+        res.edges.push_back(edge{i, successor});
+    }
+    return res;
+  }
+}
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef HRLIB_STATIC_GRAPH_SCHEDULE
+#define HRLIB_STATIC_GRAPH_SCHEDULE
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <hrlib/type_traits/type_traits.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    template <typename Node>
+    using cost_member_t = decltype(Node::cost);
+    template <typename Node, bool = type_traits::is_detected_v<cost_member_t, Node>>
+    struct node_cost_impl: std::integral_constant<std::size_t, 1> {};
+    template <typename Node>
+    struct node_cost_impl<Node, true>: std::integral_constant<std::size_t, static_cast<std::size_t>(Node::cost)> {};
+  }
+
+  // the estimated cost of a single node (ns or any other weight) given by an optional member static constexpr cost, 1 by default
+  template <typename Node>
+  struct node_cost: detail::node_cost_impl<Node> {};
+  template <typename Node>
+  constexpr std::size_t node_cost_v = node_cost<Node>::value;
+
+  namespace detail
+  {
+    template <typename Node>
+    using affinity_group_member_t = decltype(Node::affinity_group);
+    template <typename Node, bool = type_traits::is_detected_v<affinity_group_member_t, Node>>
+    struct node_affinity_group_impl: std::integral_constant<int, -1> {};
+    template <typename Node>
+    struct node_affinity_group_impl<Node, true>: std::integral_constant<int, static_cast<int>(Node::affinity_group)> {};
+  }
+
+  // the placement group of a single node given by an optional member static constexpr affinity_group, -1 (no group) by default.
+  // the nodes of a group g >= 0 run on worker g % WorkerNum, e.g. the stages of a chain which share their data stay on one core.
+  template <typename Node>
+  struct node_affinity_group: detail::node_affinity_group_impl<Node> {};
+  template <typename Node>
+  constexpr int node_affinity_group_v = node_affinity_group<Node>::value;
+
+  namespace detail
+  {
+    template <typename Graph, std::size_t... Is>
+    constexpr std::array<std::size_t, Graph::node_num> make_costs(std::index_sequence<Is...>)
+    {
+      return {{node_cost<node_at_t<Graph, Is>>::value...}};
+    }
+    template <typename Graph, std::size_t... Is>
+    constexpr std::array<int, Graph::node_num> make_affinity_groups(std::index_sequence<Is...>)
+    {
+      return {{node_affinity_group<node_at_t<Graph, Is>>::value...}};
+    }
+  }
+
+  // the critical path of a graph from the node costs.
+  // earliest_start[i] is the earliest time node i can start with unlimited workers, latest_start[i] the latest time it can start
+  // without making the graph longer, slack[i] the difference. the nodes with zero slack form the critical path.
+  template <typename Graph>
+  struct critical_path
+  {
+  private:
+    using adj = adjacency<Graph>;
+    static constexpr std::size_t node_num = Graph::node_num;
+    static constexpr auto make_earliest_start()
+    {
+      std::array<std::size_t, node_num> res{};
+      // the flat index order is a topological order
+      for (std::size_t i = 0; i < node_num; ++i)
+        for (auto p: adj::predecessors_of(i))
+          if (res[i] < res[p] + costs[p])
+            res[i] = res[p] + costs[p];
+      return res;
+    }
+  public:
+    static constexpr auto costs = detail::make_costs<Graph>(std::make_index_sequence<node_num>{});
+    static constexpr auto earliest_start = make_earliest_start();
+  private:
+    static constexpr std::size_t make_length()
+    {
+      std::size_t res = 0;
+      for (std::size_t i = 0; i < node_num; ++i)
+        if (res < earliest_start[i] + costs[i])
+          res = earliest_start[i] + costs[i];
+      return res;
+    }
+  public:
+    static constexpr std::size_t length = make_length();
+  private:
+    static constexpr auto make_latest_start()
+    {
+      std::array<std::size_t, node_num> res{};
+      for (auto i = node_num; i-- > 0;)
+      {
+        auto finish = length;
+        for (auto s: adj::successors_of(i))
+          if (finish > res[s])
+            finish = res[s];
+        res[i] = finish - costs[i];
+      }
+      return res;
+    }
+    static constexpr auto make_slack()
+    {
+      std::array<std::size_t, node_num> res{};
+      for (std::size_t i = 0; i < node_num; ++i)
+        res[i] = latest_start[i] - earliest_start[i];
+      return res;
+    }
+  public:
+    static constexpr auto latest_start = make_latest_start();
+    static constexpr auto slack = make_slack();
+    static constexpr bool is_critical(std::size_t i) { return slack[i] == 0; }
+  };
+
+  // a static list schedule of a graph on WorkerNum workers.
+  // ready nodes are taken in the order of their bottom level (the longest path from the node to the end, critical nodes first)
+  // and each one is put on the worker where it can start first, or on the worker of its affinity group if it has one.
+  // worker[i], start[i] and finish[i] give the placement of node i, the nodes of worker w are
+  // worker_nodes[worker_offsets[w]] ... worker_nodes[worker_offsets[w + 1] - 1] in the order of their start times.
+  template <typename Graph, std::size_t WorkerNum>
+  struct list_schedule
+  {
+    static_assert(WorkerNum > 0);
+  private:
+    using adj = adjacency<Graph>;
+    using path = critical_path<Graph>;
+    static constexpr std::size_t node_num = Graph::node_num;
+    struct result_type
+    {
+      std::array<std::size_t, node_num> worker{};
+      std::array<std::size_t, node_num> start{};
+      std::array<std::size_t, node_num> finish{};
+      std::array<std::size_t, node_num> order{}; // the nodes in the order they are placed
+    };
+    static constexpr auto make_bottom_levels()
+    {
+      std::array<std::size_t, node_num> res{};
+      for (auto i = node_num; i-- > 0;)
+      {
+        std::size_t longest = 0;
+        for (auto s: adj::successors_of(i))
+          if (longest < res[s])
+            longest = res[s];
+        res[i] = longest + path::costs[i];
+      }
+      return res;
+    }
+    static constexpr auto bottom_levels = make_bottom_levels();
+    static constexpr auto affinity_groups = detail::make_affinity_groups<Graph>(std::make_index_sequence<node_num>{});
+    static constexpr result_type make_result()
+    {
+      result_type res{};
+      std::array<bool, node_num> placed{};
+      std::array<std::size_t, WorkerNum> worker_free{};
+      for (std::size_t n = 0; n < node_num; ++n)
+      {
+        // the ready node with the highest bottom level, the smallest index on a tie
+        auto node = node_num;
+        for (std::size_t i = 0; i < node_num; ++i)
+        {
+          if (placed[i])
+            continue;
+          bool ready = true;
+          for (auto p: adj::predecessors_of(i))
+            ready = ready && placed[p];
+          if (ready && (node == node_num || bottom_levels[node] < bottom_levels[i]))
+            node = i;
+        }
+        std::size_t data_ready = 0;
+        for (auto p: adj::predecessors_of(node))
+          if (data_ready < res.finish[p])
+            data_ready = res.finish[p];
+        std::size_t worker = 0;
+        if (affinity_groups[node] >= 0)
+          worker = static_cast<std::size_t>(affinity_groups[node]) % WorkerNum;
+        else
+        {
+          for (std::size_t w = 1; w < WorkerNum; ++w)
+          {
+            const auto start = worker_free[w] > data_ready ? worker_free[w] : data_ready;
+            const auto best = worker_free[worker] > data_ready ? worker_free[worker] : data_ready;
+            if (start < best)
+              worker = w;
+          }
+        }
+        res.worker[node] = worker;
+        res.start[node] = worker_free[worker] > data_ready ? worker_free[worker] : data_ready;
+        res.finish[node] = res.start[node] + path::costs[node];
+        worker_free[worker] = res.finish[node];
+        res.order[n] = node;
+        placed[node] = true;
+      }
+      return res;
+    }
+    static constexpr auto result = make_result();
+    static constexpr auto make_worker_offsets()
+    {
+      std::array<std::size_t, WorkerNum + 1> res{};
+      for (std::size_t i = 0; i < node_num; ++i)
+        ++res[result.worker[i] + 1];
+      for (std::size_t w = 0; w < WorkerNum; ++w)
+        res[w + 1] += res[w];
+      return res;
+    }
+  public:
+    static constexpr std::size_t worker_num = WorkerNum;
+    static constexpr auto worker = result.worker;
+    static constexpr auto start = result.start;
+    static constexpr auto finish = result.finish;
+    static constexpr auto worker_offsets = make_worker_offsets();
+  private:
+    static constexpr auto make_worker_nodes()
+    {
+      // the nodes of a worker are placed in increasing start time
+      std::array<std::size_t, node_num> res{};
+      auto pos = worker_offsets;
+      for (auto node: result.order)
+        res[pos[result.worker[node]]++] = node;
+      return res;
+    }
+    static constexpr std::size_t make_makespan()
+    {
+      std::size_t res = 0;
+      for (auto f: result.finish)
+        if (res < f)
+          res = f;
+      return res;
+    }
+  public:
+    static constexpr auto worker_nodes = make_worker_nodes();
+    static constexpr std::size_t makespan = make_makespan();
+  };
+
+  // no schedule on WorkerNum workers can be shorter than the critical path or than the total cost shared by all workers
+  template <typename Graph, std::size_t WorkerNum>
+  struct latency_lower_bound
+  {
+  private:
+    static constexpr std::size_t total_cost()
+    {
+      std::size_t res = 0;
+      for (auto c: critical_path<Graph>::costs)
+        res += c;
+      return res;
+    }
+    static constexpr std::size_t shared = (total_cost() + WorkerNum - 1) / WorkerNum;
+  public:
+    static constexpr std::size_t value = critical_path<Graph>::length > shared ? critical_path<Graph>::length : shared;
+  };
+  template <typename Graph, std::size_t WorkerNum>
+  constexpr std::size_t latency_lower_bound_v = latency_lower_bound<Graph, WorkerNum>::value;
+}
+
+#endif
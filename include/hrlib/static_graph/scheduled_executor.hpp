@@ -0,0 +1,365 @@
+#ifndef HRLIB_STATIC_GRAPH_SCHEDULED_EXECUTOR
+#define HRLIB_STATIC_GRAPH_SCHEDULED_EXECUTOR
+
+#include <array>
+#include <cassert>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <type_traits>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/schedule.hpp>
+#include <hrlib/static_graph/instrumentation.hpp>
+
+namespace hrlib::static_graph
+{
+  namespace detail
+  {
+    inline bool pin_thread(std::thread::native_handle_type handle, int cpu)
+    {
+#if defined(__linux__)
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+#else
+      static_cast<void>(handle);
+      static_cast<void>(cpu);
+      return false;
+#endif
+    }
+  }
+
+  // pins the calling thread to a cpu. returns false, and leaves the thread as it is, when cpu is negative,
+  // the cpu is not available or pinning is not supported (anything but linux).
+  inline bool pin_current_thread(int cpu)
+  {
+#if defined(__linux__)
+    return detail::pin_thread(pthread_self(), cpu);
+#else
+    static_cast<void>(cpu);
+    return false;
+#endif
+  }
+
+  // runs the single nodes of a graph on WorkerNum threads along the list_schedule computed at compile time.
+  // every worker runs its own list of nodes in order, so there is no queue, no stealing and no decision at runtime,
+  // a node only waits until its predecessors on the other workers have finished.
+  // this suits small graphs with known node costs, where the overhead of dynamic scheduling is larger than the nodes themselves.
+  // the executor owns WorkerNum - 1 threads, the calling thread is worker 0. run() must not be called concurrently.
+  // run(Args&...) of different nodes is called concurrently with the same arguments, and it must not throw.
+  // Instrumentation is called around every node on the thread which runs the node, see instrumentation.hpp.
+  // the nodes with an affinity group run on the same worker (see list_schedule), and given a cpu per worker the worker threads are pinned,
+  // so e.g. the stages of a chain in one group run one after another on one core. a negative cpu leaves the worker unpinned.
+  // worker 0 is the calling thread, which is never pinned by the executor, pin_current_thread(cpus[0]) pins it.
+  // place(graph) copies the single nodes into a memory block per worker, which the worker allocates and constructs itself,
+  // so with the first-touch policy of linux its pages are put on the memory node of the worker's cpu (unless the allocator
+  // hands out pages which were touched before). the nodes in a block are in the order the worker runs them, and a node of another
+  // group than the node before it starts a new cache line, so two groups never share a line. run_placed(Args&...) then runs these copies.
+  // the copies keep the links of the graph they are copied from, which the executor does not follow.
+  template <typename Graph, std::size_t WorkerNum, typename Instrumentation = no_instrumentation>
+  class scheduled_executor
+  {
+  public:
+    using graph_type = Graph;
+    using schedule_type = list_schedule<Graph, WorkerNum>;
+    static constexpr std::size_t node_num = Graph::node_num;
+    static constexpr std::size_t worker_num = WorkerNum;
+  private:
+    using adj = adjacency<Graph>;
+
+    template <typename... Args>
+    struct run_state
+    {
+      Graph& graph;
+      std::tuple<Args&...> args;
+      template <std::size_t I>
+      auto& node() { return node_at<I>(graph); }
+    };
+    template <typename... Args>
+    struct placed_run_state
+    {
+      scheduled_executor& executor;
+      std::tuple<Args&...> args;
+      template <std::size_t I>
+      auto& node() { return executor.template placed_node<I>(); }
+    };
+
+    template <typename State, std::size_t I>
+    static void run_node(State& state)
+    {
+      std::apply([&state](auto&... args){ state.template node<I>().run(args...); }, state.args);
+    }
+    template <typename State, std::size_t... Is>
+    static constexpr std::array<void (*)(State&), node_num> make_dispatch_table(std::index_sequence<Is...>)
+    {
+      return {{&run_node<State, Is>...}};
+    }
+    template <typename State>
+    static constexpr auto dispatch_table = make_dispatch_table<State>(std::make_index_sequence<node_num>{});
+
+    static constexpr std::size_t cache_line_size = 64;
+    // a node has finished in the current run when its mark equals the number of the run, so the marks are never reset.
+    // every mark has its own cache line, so a worker storing a mark does not invalidate the marks others are waiting on
+    struct alignas(cache_line_size) finish_mark
+    {
+      std::atomic<std::uint64_t> epoch{0};
+    };
+    std::array<finish_mark, node_num> finished{};
+
+    template <std::size_t... Is>
+    static constexpr std::array<std::size_t, node_num> make_node_sizes(std::index_sequence<Is...>) { return {{sizeof(node_at_t<Graph, Is>)...}}; }
+    template <std::size_t... Is>
+    static constexpr std::array<std::size_t, node_num> make_node_aligns(std::index_sequence<Is...>) { return {{alignof(node_at_t<Graph, Is>)...}}; }
+    static constexpr auto node_sizes = make_node_sizes(std::make_index_sequence<node_num>{});
+    static constexpr auto node_aligns = make_node_aligns(std::make_index_sequence<node_num>{});
+    static constexpr auto affinity_groups = detail::make_affinity_groups<Graph>(std::make_index_sequence<node_num>{});
+    static constexpr std::size_t round_up(std::size_t size, std::size_t align) { return (size + align - 1) / align * align; }
+    static constexpr std::size_t make_block_align()
+    {
+      std::size_t res = cache_line_size;
+      for (auto align: node_aligns)
+        if (res < align)
+          res = align;
+      return res;
+    }
+    static constexpr std::size_t block_align = make_block_align();
+    struct placement_layout
+    {
+      std::array<std::size_t, node_num> offset{}; // in the block of the node's worker
+      std::array<std::size_t, WorkerNum> block_size{};
+    };
+    static constexpr placement_layout make_layout()
+    {
+      placement_layout res{};
+      for (std::size_t w = 0; w < WorkerNum; ++w)
+      {
+        std::size_t size = 0;
+        for (auto i = schedule_type::worker_offsets[w]; i < schedule_type::worker_offsets[w + 1]; ++i)
+        {
+          const auto index = schedule_type::worker_nodes[i];
+          auto align = node_aligns[index];
+          if (i != schedule_type::worker_offsets[w] && affinity_groups[index] != affinity_groups[schedule_type::worker_nodes[i - 1]] && align < cache_line_size)
+            align = cache_line_size;
+          size = round_up(size, align);
+          res.offset[index] = size;
+          size += node_sizes[index];
+        }
+        res.block_size[w] = round_up(size, cache_line_size);
+      }
+      return res;
+    }
+    static constexpr auto layout = make_layout();
+
+    template <std::size_t I>
+    static void copy_node(void* ptr, const Graph& graph) { ::new (ptr) node_at_t<Graph, I>(node_at<I>(graph)); }
+    template <std::size_t I>
+    static void destroy_node(void* ptr) noexcept { static_cast<node_at_t<Graph, I>*>(ptr)->~node_at_t<Graph, I>(); }
+    template <std::size_t... Is>
+    static constexpr std::array<void (*)(void*, const Graph&), node_num> make_copy_table(std::index_sequence<Is...>) { return {{&copy_node<Is>...}}; }
+    template <std::size_t... Is>
+    static constexpr std::array<void (*)(void*) noexcept, node_num> make_destroy_table(std::index_sequence<Is...>) { return {{&destroy_node<Is>...}}; }
+    static constexpr auto copy_table = make_copy_table(std::make_index_sequence<node_num>{});
+    static constexpr auto destroy_table = make_destroy_table(std::make_index_sequence<node_num>{});
+
+    std::array<unsigned char*, WorkerNum> blocks{};
+    std::array<bool, node_num> constructed{};
+    std::array<std::exception_ptr, WorkerNum> place_errors{};
+    bool placed = false;
+
+    // runs on the worker, so the block is allocated and first written by the thread which runs its nodes
+    void place_nodes(const Graph& graph, std::size_t worker)
+    {
+      try
+      {
+        if (layout.block_size[worker] == 0)
+          return;
+        blocks[worker] = static_cast<unsigned char*>(::operator new(layout.block_size[worker], std::align_val_t{block_align}));
+        for (auto i = schedule_type::worker_offsets[worker]; i < schedule_type::worker_offsets[worker + 1]; ++i)
+        {
+          const auto index = schedule_type::worker_nodes[i];
+          copy_table[index](blocks[worker] + layout.offset[index], graph);
+          constructed[index] = true;
+        }
+      }
+      catch (...)
+      {
+        place_errors[worker] = std::current_exception();
+      }
+    }
+    static void place_job(scheduled_executor& executor, void* graph, std::size_t worker) { executor.place_nodes(**static_cast<const Graph**>(graph), worker); }
+    void release_placement() noexcept
+    {
+      for (std::size_t i = 0; i < node_num; ++i)
+        if (constructed[i])
+          destroy_table[i](blocks[schedule_type::worker[i]] + layout.offset[i]);
+      for (auto& block: blocks)
+        if (block != nullptr)
+          ::operator delete(block, std::align_val_t{block_align});
+      blocks = {};
+      constructed = {};
+      placed = false;
+    }
+    std::uint64_t epoch = 0;
+    Instrumentation instrumentation;
+
+    template <typename State>
+    void run_list(State& state, std::size_t worker)
+    {
+      for (auto i = schedule_type::worker_offsets[worker]; i < schedule_type::worker_offsets[worker + 1]; ++i)
+      {
+        const auto index = schedule_type::worker_nodes[i];
+        for (auto predecessor: adj::predecessors_of(index))
+          // the predecessors on the same worker have finished already
+          if (schedule_type::worker[predecessor] != worker)
+            while (finished[predecessor].epoch.load(std::memory_order_acquire) != epoch)
+              std::this_thread::yield();
+        instrumentation.on_enter(index);
+        dispatch_table<State>[index](state);
+        instrumentation.on_exit(index);
+        finished[index].epoch.store(epoch, std::memory_order_release);
+      }
+    }
+    template <typename State>
+    static void run_job(scheduled_executor& executor, void* state, std::size_t worker) { executor.run_list(*static_cast<State*>(state), worker); }
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::uint64_t generation = 0; // the number of started runs, guarded by mutex
+    bool stopped = false;
+    void (*job)(scheduled_executor&, void*, std::size_t) = nullptr;
+    void* job_state = nullptr;
+    std::atomic<std::size_t> active{0};
+    std::array<bool, WorkerNum> pinned{};
+
+    // runs job on every worker, worker 0 on the calling thread, and waits until all of them have finished
+    void run_on_workers(void (*worker_job)(scheduled_executor&, void*, std::size_t), void* state)
+    {
+      if constexpr (WorkerNum > 1)
+      {
+        active.store(WorkerNum - 1, std::memory_order_relaxed);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          job = worker_job;
+          job_state = state;
+          ++generation;
+        }
+        cv.notify_all();
+      }
+      worker_job(*this, state, 0);
+      while (active.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+    }
+    void worker_loop(std::size_t worker)
+    {
+      std::uint64_t seen = 0;
+      while (true)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [this, seen]{ return stopped || generation != seen; });
+          if (stopped)
+            return;
+          seen = generation;
+        }
+        job(*this, job_state, worker);
+        active.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    }
+  public:
+    explicit scheduled_executor(const Instrumentation& instrumentation = Instrumentation()): instrumentation(instrumentation)
+    {
+      threads.reserve(WorkerNum - 1);
+      for (std::size_t w = 1; w < WorkerNum; ++w)
+        threads.emplace_back([this, w]{ worker_loop(w); });
+    }
+    // pins worker w (w > 0) to cpus[w], a worker whose cpu is negative or not available is left unpinned
+    explicit scheduled_executor(const std::array<int, WorkerNum>& cpus, const Instrumentation& instrumentation = Instrumentation())
+      : scheduled_executor(instrumentation)
+    {
+      for (std::size_t w = 1; w < WorkerNum; ++w)
+        pinned[w] = detail::pin_thread(threads[w - 1].native_handle(), cpus[w]);
+    }
+    scheduled_executor(const scheduled_executor&) = delete;
+    scheduled_executor& operator=(const scheduled_executor&) = delete;
+    ~scheduled_executor()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+      }
+      cv.notify_all();
+      for (auto& thread: threads)
+        thread.join();
+      release_placement();
+    }
+    // whether the thread of worker w has been pinned to its cpu, always false for worker 0
+    bool is_pinned(std::size_t worker) const noexcept { return pinned[worker]; }
+    template <typename... Args>
+    void run(Graph& graph, Args&&... args)
+    {
+      using state_type = run_state<std::remove_reference_t<Args>...>;
+      state_type state{graph, std::tie(args...)};
+      ++epoch;
+      run_on_workers(&run_job<state_type>, &state);
+    }
+    // copies the single nodes of graph into the blocks of their workers, replacing the nodes placed before.
+    // an exception thrown by a copy constructor or the allocation is rethrown after the nodes copied so far are destroyed
+    void place(const Graph& graph)
+    {
+      release_placement();
+      auto source = &graph;
+      run_on_workers(&place_job, &source);
+      for (auto& error: place_errors)
+        if (error)
+        {
+          auto res = std::exchange(error, nullptr);
+          for (auto& other: place_errors)
+            other = nullptr;
+          release_placement();
+          std::rethrow_exception(res);
+        }
+      placed = true;
+    }
+    bool is_placed() const noexcept { return placed; }
+    // the copy of the I-th node made by place(), it lives in the block of worker schedule_type::worker[I]
+    template <std::size_t I>
+    node_at_t<Graph, I>& placed_node() noexcept
+    {
+      return *std::launder(reinterpret_cast<node_at_t<Graph, I>*>(blocks[schedule_type::worker[I]] + layout.offset[I]));
+    }
+    template <std::size_t I>
+    const node_at_t<Graph, I>& placed_node() const noexcept
+    {
+      return *std::launder(reinterpret_cast<const node_at_t<Graph, I>*>(blocks[schedule_type::worker[I]] + layout.offset[I]));
+    }
+    // runs the nodes copied by place(), as run(graph, args...) runs the nodes of graph
+    template <typename... Args>
+    void run_placed(Args&&... args)
+    {
+      assert(placed);
+      using state_type = placed_run_state<std::remove_reference_t<Args>...>;
+      state_type state{*this, std::tie(args...)};
+      ++epoch;
+      run_on_workers(&run_job<state_type>, &state);
+    }
+  };
+}
+
+#endif
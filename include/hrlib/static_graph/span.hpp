@@ -0,0 +1,41 @@
+#ifndef HRLIB_STATIC_GRAPH_SPAN
+#define HRLIB_STATIC_GRAPH_SPAN
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hrlib::static_graph
+{
+  // a minimal non-owning view of contiguous elements, a subset of std::span for C++17
+  template <typename T>
+  class span
+  {
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+  private:
+    pointer ptr = nullptr;
+    size_type len = 0;
+  public:
+    constexpr span() = default;
+    constexpr span(pointer ptr, size_type size): ptr(ptr), len(size) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(const span<U>& other): ptr(other.data()), len(other.size()) {}
+    constexpr span(const span&) = default;
+    constexpr span& operator=(const span&) = default;
+    ~span() = default;
+    constexpr pointer data() const { return ptr; }
+    constexpr size_type size() const { return len; }
+    constexpr bool empty() const { return len == 0; }
+    constexpr reference operator[](size_type i) const { return ptr[i]; }
+    constexpr iterator begin() const { return ptr; }
+    constexpr iterator end() const { return ptr + len; }
+    constexpr span subspan(size_type offset, size_type count) const { return span(ptr + offset, count); }
+  };
+}
+
+#endif
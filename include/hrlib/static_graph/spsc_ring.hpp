@@ -0,0 +1,102 @@
+#ifndef HRLIB_STATIC_GRAPH_SPSC_RING
+#define HRLIB_STATIC_GRAPH_SPSC_RING
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace hrlib::static_graph
+{
+  // a bounded lock-free queue for exactly one producer thread and one consumer thread.
+  // the capacity is rounded up to a power of two. the producer and the consumer indices live on different cache lines,
+  // and each side caches the index of the other side so that it reads the shared index only when the ring looks full or empty.
+  // the producer calls close() after the last push, then the consumer sees is_drained() once it has popped everything.
+  template <typename T>
+  class spsc_ring
+  {
+    static constexpr std::size_t cache_line_size = 64;
+    struct slot
+    {
+      alignas(T) unsigned char storage[sizeof(T)];
+      T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+    static std::size_t round_up(std::size_t capacity)
+    {
+      std::size_t res = 1;
+      while (res < capacity)
+        res <<= 1;
+      return res;
+    }
+
+    std::size_t mask;
+    std::unique_ptr<slot[]> slots;
+    alignas(cache_line_size) std::atomic<std::size_t> head{0}; // written by the consumer
+    std::size_t cached_tail = 0;
+    alignas(cache_line_size) std::atomic<std::size_t> tail{0}; // written by the producer
+    std::size_t cached_head = 0;
+    std::atomic<bool> closed{false};
+  public:
+    using value_type = T;
+    explicit spsc_ring(std::size_t capacity): mask(round_up(capacity) - 1), slots(new slot[mask + 1]) {}
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+    ~spsc_ring()
+    {
+      for (auto i = head.load(std::memory_order_relaxed); i != tail.load(std::memory_order_relaxed); ++i)
+        slots[i & mask].get()->~T();
+    }
+    std::size_t capacity() const noexcept { return mask + 1; }
+    // the number of queued elements, exact only when called from the producer or the consumer thread
+    std::size_t size() const noexcept { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+    // producer side
+    template <typename U>
+    bool try_push(U&& value)
+    {
+      const auto t = tail.load(std::memory_order_relaxed);
+      if (t - cached_head == capacity())
+      {
+        cached_head = head.load(std::memory_order_acquire);
+        if (t - cached_head == capacity())
+          return false;
+      }
+      new (slots[t & mask].storage) T(std::forward<U>(value));
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+    void close() noexcept { closed.store(true, std::memory_order_release); }
+
+    // consumer side
+    // passes the front element as an rvalue to f, f must not throw
+    template <typename F>
+    bool try_consume(F&& f)
+    {
+      const auto h = head.load(std::memory_order_relaxed);
+      if (h == cached_tail)
+      {
+        cached_tail = tail.load(std::memory_order_acquire);
+        if (h == cached_tail)
+          return false;
+      }
+      auto* p = slots[h & mask].get();
+      std::forward<F>(f)(std::move(*p));
+      p->~T();
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+    bool try_pop(T& value) { return try_consume([&value](T&& v){ value = std::move(v); }); }
+    // the number of queued elements the consumer knows of from its cached tail, it reads no index of the producer.
+    // exact right after the consumer has read the tail (when it found the ring empty), a lower bound otherwise
+    std::size_t known_size() const noexcept { return cached_tail - head.load(std::memory_order_relaxed); }
+    // true when the producer has closed the ring and every element has been popped
+    bool is_drained() const noexcept
+    {
+      // closed must be read before tail, the producer stores tail before it closes the ring
+      return closed.load(std::memory_order_acquire) && head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+  };
+}
+
+#endif
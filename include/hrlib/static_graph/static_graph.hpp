@@ -30,7 +30,67 @@ namespace hrlib::static_graph
   struct or_node_tag{};
 
   struct terminal_node { static constexpr bool is_visited = true; };
-  static constexpr auto terminal = terminal_node{};
+  inline constexpr auto terminal = terminal_node{};
+
+  // how a single node refers to its successors.
+  // pointer_link_tag: the node holds pointers in next, which are set by construct_connection().
+  // index_link_tag: the node holds nothing, the successors are the compile-time indices given by successors_t (see topology.hpp).
+  //                 such nodes are valid right after construction and can be copied, moved or memcpy'd freely.
+  struct pointer_link_tag{};
+  struct index_link_tag{};
+
+  namespace detail
+  {
+    template <typename Node>
+    using link_tag_member_t = typename std::decay_t<Node>::link_tag;
+    template <typename Node>
+    using next_member_t = decltype(std::declval<Node>().next);
+    template <typename Node, bool = type_traits::is_detected_v<link_tag_member_t, Node>>
+    struct link_tag_impl: type_traits::identity<pointer_link_tag> {};
+    template <typename Node>
+    struct link_tag_impl<Node, true>: type_traits::identity<link_tag_member_t<Node>> {};
+    template <typename Node>
+    using link_constraints_t = std::enable_if_t<
+      std::is_same_v<typename link_tag_impl<Node>::type, index_link_tag> || type_traits::is_detected_v<next_member_t, Node>
+    >;
+  }
+
+  // a single node is rebound to a new successor type by either
+  //   copy<NextNodeType>() const: copies the payload, or
+  //   rebind<NextNodeType>() &&: moves the payload out of an expiring node.
+  // rebind_node() moves whenever the node is an rvalue and has rebind, so composing rvalues never copies the payload.
+  namespace detail
+  {
+    template <typename Node, typename NextNodeType = terminal_node>
+    using copy_member_t = decltype(std::declval<const Node&>().template copy<NextNodeType>());
+    template <typename Node, typename NextNodeType = terminal_node>
+    using rebind_member_t = decltype(std::declval<Node>().template rebind<NextNodeType>());
+    template <typename Node>
+    using rebind_constraints_t = std::enable_if_t<
+      type_traits::is_detected_v<copy_member_t, std::decay_t<Node>> || type_traits::is_detected_v<rebind_member_t, std::decay_t<Node>>
+    >;
+
+    template <typename NextNodeType, typename Node>
+    constexpr auto rebind_node(Node&& node)
+    {
+      using NodeType = std::decay_t<Node>;
+      if constexpr (!std::is_lvalue_reference_v<Node> && type_traits::is_detected_v<rebind_member_t, NodeType, NextNodeType>)
+        return std::move(node).template rebind<NextNodeType>();
+      else if constexpr (type_traits::is_detected_v<copy_member_t, NodeType, NextNodeType>)
+        return node.template copy<NextNodeType>();
+      else
+        return NodeType(node).template rebind<NextNodeType>();
+    }
+    template <typename Node, typename NextNodeType>
+    using rebound_node_t = decltype(rebind_node<NextNodeType>(std::declval<Node>()));
+  }
+
+  template <typename Node>
+  struct link_tag: detail::link_tag_impl<Node> {};
+  template <typename Node>
+  using link_tag_t = typename link_tag<Node>::type;
+  template <typename Node>
+  constexpr bool is_index_linked_v = std::is_same_v<link_tag_t<Node>, index_link_tag>;
 
   namespace detail
   {
@@ -43,8 +103,8 @@ namespace hrlib::static_graph
         std::enable_if_t<std::is_same_v<typename std::decay_t<Node>::node_type_tag, single_node_tag>>,
         decltype(std::decay_t<Node>::make_chained(std::declval<std::tuple<std::decay_t<Node>, std::decay_t<Node>>>())),
         decltype(std::decay_t<Node>::make_or(std::declval<std::tuple<std::decay_t<Node>, std::decay_t<Node>>>())),
-        decltype(std::declval<Node>().template copy<terminal_node>()),
-        decltype(std::declval<Node>().next),
+        rebind_constraints_t<Node>,
+        link_constraints_t<Node>,
         decltype(std::declval<Node>().construct_connection())
       >
     >: std::true_type {};
@@ -205,23 +265,104 @@ namespace hrlib::static_graph
   template <typename Node>
   using node_lasts_t = typename node_lasts<Node>::type;
 
-  template <typename NextNodeType>
+  // single nodes are indexed in the order they appear in the expression (pre-order over the contents of chained_node/or_node).
+  // every edge goes from a smaller index to a larger one, so this order is also a topological order of the graph.
+  namespace detail
+  {
+    template <typename Tpl>
+    struct composite_node_helper;
+    template <typename... Ns>
+    struct composite_node_helper<std::tuple<Ns...>>
+    {
+      static constexpr std::size_t sizes[] = {Ns::node_num...};
+      static constexpr std::size_t child_of(std::size_t index)
+      {
+        std::size_t i = 0;
+        while (index >= sizes[i])
+          index -= sizes[i++];
+        return i;
+      }
+      static constexpr std::size_t offset_of(std::size_t child)
+      {
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < child; ++i)
+          offset += sizes[i];
+        return offset;
+      }
+    };
+
+    template <typename Node, typename NodeTypeTag = typename Node::node_type_tag>
+    struct flat_nodes_impl
+    {
+      using helper = composite_node_helper<typename Node::content_type>;
+      using type = typename flat_nodes_impl<typename Node::content_type, void>::type;
+      template <std::size_t I, typename N>
+      static constexpr auto& get(N& node)
+      {
+        static_assert(I < Node::node_num);
+        constexpr auto child = helper::child_of(I);
+        using child_type = std::tuple_element_t<child, typename Node::content_type>;
+        return flat_nodes_impl<child_type>::template get<I - helper::offset_of(child)>(std::get<child>(node.get_nodes()));
+      }
+    };
+    template <typename... Ns>
+    struct flat_nodes_impl<std::tuple<Ns...>, void>
+    {
+      using type = type_traits::concat_t<typename flat_nodes_impl<Ns>::type...>;
+    };
+    template <typename SingleNode>
+    struct flat_nodes_impl<SingleNode, single_node_tag>
+    {
+      using type = type_list<SingleNode>;
+      template <std::size_t I, typename N>
+      static constexpr auto& get(N& node)
+      {
+        static_assert(I == 0);
+        return node;
+      }
+    };
+  }
+
+  template <typename Node>
+  struct flat_nodes: detail::flat_nodes_impl<Node> {};
+  template <typename Node>
+  using flat_nodes_t = typename flat_nodes<Node>::type;
+
+  template <typename Node, std::size_t I>
+  using node_at_t = type_traits::get_t<flat_nodes_t<Node>, I>;
+
+  template <std::size_t I, typename Node>
+  constexpr auto& node_at(Node& node) { return detail::flat_nodes_impl<std::remove_const_t<Node>>::template get<I>(node); }
+
+  // an interior pointer link holds one full pointer per successor in every graph instance, only the links of the last nodes take no storage.
+  // pointer links are not narrowed, a graph without per-instance link storage uses index_link_tag and the tables of topology.hpp.
+  template <typename NextNodeType, typename LinkTag = pointer_link_tag>
   struct next_node
   {
+    using link_tag = pointer_link_tag;
     using next_hold_type = std::add_pointer_t<NextNodeType>;
     next_hold_type next{};
   };
   template <typename... Ts>
-  struct next_node<std::tuple<Ts...>>
+  struct next_node<std::tuple<Ts...>, pointer_link_tag>
   {
+    using link_tag = pointer_link_tag;
     using next_hold_type = std::tuple<std::add_pointer_t<Ts>...>;
     next_hold_type next{};
   };
+  // a last node links to the terminal node, which is the same for every node, so the link takes no storage
   template <>
-  struct next_node<terminal_node>
+  struct next_node<terminal_node, pointer_link_tag>
   {
+    using link_tag = pointer_link_tag;
     using next_hold_type = const terminal_node*;
-    next_hold_type next = &terminal;
+    static constexpr next_hold_type next = &terminal;
+  };
+  template <typename NextNodeType>
+  struct next_node<NextNodeType, index_link_tag>
+  {
+    using link_tag = index_link_tag;
+    using next_node_type = NextNodeType;
   };
 
   template <typename N1, typename N2, typename... Ns>
@@ -257,13 +398,16 @@ namespace hrlib::static_graph
       {
         using Node1NextNodeTypeTuple = type_list_meta::to_tuple_t<node_heads_t<std::tuple_element_t<0, Node2Type>>>;
         using Node1NextNodeType = std::conditional_t<std::tuple_size_v<Node1NextNodeTypeTuple> == 1, std::tuple_element_t<0, Node1NextNodeTypeTuple>, Node1NextNodeTypeTuple>;
-        return std::tuple_cat(std::make_tuple(node1.template copy<Node1NextNodeType>()), std::forward<Node2>(node2));
+        return std::tuple_cat(std::make_tuple(detail::rebind_node<Node1NextNodeType>(std::forward<Node1>(node1))), std::forward<Node2>(node2));
       }
       else
       {
-        using Node1NextNodeTypeTuple = type_list_meta::to_tuple_t<node_heads_t<decltype(node2.template copy<NextNodeType>())>>;
+        using Node1NextNodeTypeTuple = type_list_meta::to_tuple_t<node_heads_t<detail::rebound_node_t<Node2, NextNodeType>>>;
         using Node1NextNodeType = std::conditional_t<std::tuple_size_v<Node1NextNodeTypeTuple> == 1, std::tuple_element_t<0, Node1NextNodeTypeTuple>, Node1NextNodeTypeTuple>;
-        return std::make_tuple(node1.template copy<Node1NextNodeType>(), node2.template copy<NextNodeType>());
+        return std::make_tuple(
+          detail::rebind_node<Node1NextNodeType>(std::forward<Node1>(node1)),
+          detail::rebind_node<NextNodeType>(std::forward<Node2>(node2))
+        );
       }
     }
     template <typename... Nodes>
@@ -272,6 +416,8 @@ namespace hrlib::static_graph
     static constexpr auto make(std::tuple<Nodes...>&& nodes) { return chained_node<Nodes...>(std::move(nodes)); }
     template <typename NextNodeType, std::size_t... Is>
     constexpr auto copy_impl(std::index_sequence<Is...>) const { return merge<NextNodeType>(std::get<Is>(ns)...); }
+    template <typename NextNodeType, std::size_t... Is>
+    constexpr auto rebind_impl(std::index_sequence<Is...>) && { return merge<NextNodeType>(std::get<Is>(std::move(ns))...); }
     template <std::size_t I, typename Tuple1, typename Tuple2>
     static constexpr void set_tuple_helper(Tuple1&& t1, Tuple2&& t2)
     {
@@ -284,7 +430,9 @@ namespace hrlib::static_graph
     {
       if constexpr (I < std::tuple_size_v<Tuple1>)
       {
-        if constexpr (std::tuple_size_v<std::decay_t<Tuple2>> == 1)
+        if constexpr (is_index_linked_v<std::remove_pointer_t<std::tuple_element_t<I, Tuple1>>>)
+          ; // the successors are given by the position in the graph
+        else if constexpr (std::tuple_size_v<std::decay_t<Tuple2>> == 1)
           std::get<I>(t1)->next = std::get<0>(t2);
         else
           set_tuple_helper<0>(std::get<I>(t1)->next, t2);
@@ -308,6 +456,8 @@ namespace hrlib::static_graph
     constexpr content_type&& get_nodes() && { return std::move(ns); }
     template <typename NextNodeType>
     constexpr auto copy() const { return make(copy_impl<NextNodeType>(std::make_index_sequence<sizeof...(Ns) + 2>{})); }
+    template <typename NextNodeType>
+    constexpr auto rebind() && { return make(std::move(*this).template rebind_impl<NextNodeType>(std::make_index_sequence<sizeof...(Ns) + 2>{})); }
     constexpr void construct_connection() { construct_connection_impl<0>(); }
   };
 
@@ -330,7 +480,9 @@ namespace hrlib::static_graph
     template <typename... Nodes>
     static constexpr auto make(std::tuple<Nodes...>&& nodes) { return or_node<Nodes...>(std::move(nodes)); }
     template <typename NextNodeType, std::size_t... Is>
-    constexpr auto copy_impl(std::index_sequence<Is...>) const { return std::make_tuple(std::get<Is>(ns).template copy<NextNodeType>()...); }
+    constexpr auto copy_impl(std::index_sequence<Is...>) const { return std::make_tuple(detail::rebind_node<NextNodeType>(std::get<Is>(ns))...); }
+    template <typename NextNodeType, std::size_t... Is>
+    constexpr auto rebind_impl(std::index_sequence<Is...>) && { return std::make_tuple(detail::rebind_node<NextNodeType>(std::get<Is>(std::move(ns)))...); }
     template <std::size_t I>
     constexpr void construct_connection_impl()
     {
@@ -349,13 +501,16 @@ namespace hrlib::static_graph
     constexpr content_type&& get_nodes() && { return std::move(ns); }
     template <typename NextNodeType>
     constexpr auto copy() const { return make(copy_impl<NextNodeType>(std::make_index_sequence<sizeof...(Ns) + 2>{})); }
+    template <typename NextNodeType>
+    constexpr auto rebind() && { return make(std::move(*this).template rebind_impl<NextNodeType>(std::make_index_sequence<sizeof...(Ns) + 2>{})); }
     constexpr void construct_connection() { construct_connection_impl<0>(); }
   };
 
-  template <typename NextNode = terminal_node>
-  struct single_node_base: next_node<NextNode>
+  template <typename NextNode = terminal_node, typename LinkTag = pointer_link_tag>
+  struct single_node_base: next_node<NextNode, LinkTag>
   {
     using node_type_tag = single_node_tag;
+    static constexpr std::size_t node_num = 1;
     template <typename... Ns>
     static constexpr auto make_chained(const std::tuple<Ns...>& ns) { return chained_node(ns); }
     template <typename... Ns>
@@ -373,8 +528,8 @@ namespace hrlib::static_graph
   struct is_combinable_single_node_impl<
     Node,
     std::void_t<
-      decltype(std::declval<Node>().template copy<terminal_node>()),
-      decltype(std::declval<Node>().next),
+      detail::rebind_constraints_t<Node>,
+      detail::link_constraints_t<Node>,
       decltype(std::declval<Node>().construct_connection())
     >
   >: std::true_type{};
@@ -409,7 +564,7 @@ namespace hrlib::static_graph
     using Node2Heads = type_list_meta::to_tuple_t<node_heads_t<Node2>>;
     using Node1NewNextNodes = std::conditional_t<std::tuple_size_v<Node2Heads> == 1, std::tuple_element_t<0, Node2Heads>, Node2Heads>;
     using ContentNodeType = std::tuple_element_t<0, Node2Heads>; // this type is used for calling static function make_chained
-    auto head_nodes = n1.template copy<Node1NewNextNodes>();
+    auto head_nodes = detail::rebind_node<Node1NewNextNodes>(std::forward<N1>(n1));
     if constexpr (
       std::is_same_v<typename Node1::node_type_tag, chained_node_tag> &&
       std::is_same_v<typename Node2::node_type_tag, chained_node_tag>
@@ -475,6 +630,107 @@ namespace hrlib::static_graph
       return ContentNodeType::make_or(std::tuple(std::forward<N1>(n1), std::forward<N2>(n2)));
     }
   }
+  // single-pass builders, make_chain(n1, n2, ..., nk) builds the same graph as n1 + n2 + ... + nk
+  // and make_parallel(n1, n2, ..., nk) the same graph as n1 | n2 | ... | nk.
+  // repeated operator+ rebinds the whole left hand side chain at every step, which instantiates and copies O(k^2) nodes.
+  // make_chain computes the final next node type of every node in one pass from right to left and rebinds every node once.
+  namespace detail
+  {
+    template <typename Node>
+    using next_node_type_t = std::conditional_t<
+      type_traits::size_v<node_heads_t<Node>> == 1,
+      type_traits::head_t<node_heads_t<Node>>,
+      type_list_meta::to_tuple_t<node_heads_t<Node>>
+    >;
+
+    template <typename Tag, typename Node>
+    constexpr auto builder_elements(Node&& node)
+    {
+      if constexpr (std::is_same_v<typename std::decay_t<Node>::node_type_tag, Tag>)
+        return std::apply(
+          [](auto&&... ns){ return std::forward_as_tuple(std::forward<decltype(ns)>(ns)...); },
+          std::forward<Node>(node).get_nodes()
+        );
+      else
+        return std::forward_as_tuple(std::forward<Node>(node));
+    }
+
+    template <typename Tpl>
+    struct rebound_chain;
+    template <typename N>
+    struct rebound_chain<std::tuple<N>>
+    {
+      using type = std::tuple<std::decay_t<N>>;
+    };
+    template <typename N, typename... Ns>
+    struct rebound_chain<std::tuple<N, Ns...>>
+    {
+    private:
+      using tail_type = typename rebound_chain<std::tuple<Ns...>>::type;
+    public:
+      using type = type_traits::push_front_t<
+        tail_type,
+        rebound_node_t<N, next_node_type_t<std::tuple_element_t<0, tail_type>>>
+      >;
+    };
+
+    template <typename ContentType, typename Refs, std::size_t... Is>
+    constexpr auto rebind_chain(Refs&& refs, std::index_sequence<Is...>)
+    {
+      return ContentType(
+        rebind_node<next_node_type_t<std::tuple_element_t<Is + 1, ContentType>>>(std::get<Is>(std::forward<Refs>(refs)))...,
+        std::get<sizeof...(Is)>(std::forward<Refs>(refs))
+      );
+    }
+  }
+
+  template <
+    typename N1,
+    typename N2,
+    typename... Ns,
+    typename = std::enable_if_t<
+      std::conjunction_v<is_combinable_node<std::decay_t<N1>>, is_combinable_node<std::decay_t<N2>>, is_combinable_node<std::decay_t<Ns>>...>
+    >
+  >
+  constexpr auto make_chain(N1&& n1, N2&& n2, Ns&&... ns)
+  {
+    using LastNode = std::decay_t<typename type_traits::last<type_list<N2, Ns...>>::type>;
+    using ContentNodeType = type_traits::head_t<node_heads_t<LastNode>>; // this type is used for calling static function make_chained
+    auto refs = std::tuple_cat(
+      detail::builder_elements<chained_node_tag>(std::forward<N1>(n1)),
+      detail::builder_elements<chained_node_tag>(std::forward<N2>(n2)),
+      detail::builder_elements<chained_node_tag>(std::forward<Ns>(ns))...
+    );
+    using refs_type = decltype(refs);
+    using content_type = typename detail::rebound_chain<refs_type>::type;
+    return ContentNodeType::make_chained(
+      detail::rebind_chain<content_type>(std::move(refs), std::make_index_sequence<std::tuple_size_v<refs_type> - 1>{})
+    );
+  }
+
+  template <
+    typename N1,
+    typename N2,
+    typename... Ns,
+    typename = std::enable_if_t<
+      std::conjunction_v<is_combinable_node<std::decay_t<N1>>, is_combinable_node<std::decay_t<N2>>, is_combinable_node<std::decay_t<Ns>>...>
+    >
+  >
+  constexpr auto make_parallel(N1&& n1, N2&& n2, Ns&&... ns)
+  {
+    using LastNode = std::decay_t<typename type_traits::last<type_list<N2, Ns...>>::type>;
+    using ContentNodeType = type_traits::head_t<node_heads_t<LastNode>>; // this type is used for calling static function make_or
+    return ContentNodeType::make_or(
+      std::apply(
+        [](auto&&... es){ return std::tuple<std::decay_t<decltype(es)>...>(std::forward<decltype(es)>(es)...); },
+        std::tuple_cat(
+          detail::builder_elements<or_node_tag>(std::forward<N1>(n1)),
+          detail::builder_elements<or_node_tag>(std::forward<N2>(n2)),
+          detail::builder_elements<or_node_tag>(std::forward<Ns>(ns))...
+        )
+      )
+    );
+  }
 }
 
 #endif
@@ -0,0 +1,500 @@
+#ifndef HRLIB_STATIC_GRAPH_TOPOLOGY
+#define HRLIB_STATIC_GRAPH_TOPOLOGY
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <tuple>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/span.hpp>
+
+namespace hrlib::static_graph
+{
+  // the smallest unsigned integer type which holds every value up to N.
+  // the index tables of a graph use it, so a graph of up to 255 nodes and edges needs one byte per entry instead of eight.
+  // the tables are static data shared by all instances of a graph type, the size of a graph instance does not change with it.
+  // a graph whose instances must be small uses index_link_tag, which replaces every link by these tables.
+  template <std::size_t N>
+  using node_index_t = std::conditional_t<
+    (N <= 0xff), std::uint8_t,
+    std::conditional_t<(N <= 0xffff), std::uint16_t, std::conditional_t<(N <= 0xffffffff), std::uint32_t, std::size_t>>
+  >;
+
+  // an edge between two single nodes, both ends are indices in the order of flat_nodes_t
+  struct edge
+  {
+    std::size_t from;
+    std::size_t to;
+  };
+
+  namespace detail
+  {
+    template <std::size_t N, std::size_t M>
+    constexpr void append_indices(std::array<std::size_t, N>& res, std::size_t& pos, const std::array<std::size_t, M>& indices, std::size_t offset)
+    {
+      for (auto index: indices)
+        res[pos++] = index + offset;
+    }
+    template <std::size_t N, std::size_t M>
+    constexpr void append_edges(std::array<edge, N>& res, std::size_t& pos, const std::array<edge, M>& edges, std::size_t offset)
+    {
+      for (auto e: edges)
+        res[pos++] = edge{e.from + offset, e.to + offset};
+    }
+    template <std::size_t N, std::size_t L, std::size_t H>
+    constexpr void append_links(std::array<edge, N>& res, std::size_t& pos, const std::array<std::size_t, L>& lasts, std::size_t lasts_offset, const std::array<std::size_t, H>& heads, std::size_t heads_offset)
+    {
+      for (auto last: lasts)
+        for (auto head: heads)
+          res[pos++] = edge{last + lasts_offset, head + heads_offset};
+    }
+
+    // heads, lasts and edges of a node, all indices are local to the node
+    template <typename Node, typename NodeTypeTag = typename Node::node_type_tag>
+    struct topology_impl;
+    template <typename Node, typename NodeTypeTag, typename Tpl = typename Node::content_type>
+    struct composite_topology_helper;
+
+    template <typename SingleNode>
+    struct topology_impl<SingleNode, single_node_tag>
+    {
+      static constexpr std::size_t node_num = 1;
+      static constexpr std::array<std::size_t, 1> heads = {0};
+      static constexpr std::array<std::size_t, 1> lasts = {0};
+      static constexpr std::array<edge, 0> edges = {};
+    };
+    template <typename ChainedNode>
+    struct topology_impl<ChainedNode, chained_node_tag>: composite_topology_helper<ChainedNode, chained_node_tag> {};
+    template <typename OrNode>
+    struct topology_impl<OrNode, or_node_tag>: composite_topology_helper<OrNode, or_node_tag> {};
+
+    template <typename Node, typename... Ns>
+    struct composite_topology_helper<Node, chained_node_tag, std::tuple<Ns...>>
+    {
+    private:
+      using helper = composite_node_helper<std::tuple<Ns...>>;
+      using first_type = topology_impl<std::tuple_element_t<0, std::tuple<Ns...>>>;
+      using last_type = topology_impl<std::tuple_element_t<sizeof...(Ns) - 1, std::tuple<Ns...>>>;
+      static constexpr std::size_t link_num()
+      {
+        constexpr std::size_t last_nums[] = {topology_impl<Ns>::lasts.size()...};
+        constexpr std::size_t head_nums[] = {topology_impl<Ns>::heads.size()...};
+        std::size_t num = 0;
+        for (std::size_t i = 0; i + 1 < sizeof...(Ns); ++i)
+          num += last_nums[i] * head_nums[i + 1];
+        return num;
+      }
+      static constexpr std::size_t edge_num = (topology_impl<Ns>::edges.size() + ...) + link_num();
+      template <std::size_t... Is, std::size_t... Js>
+      static constexpr auto make_edges(std::index_sequence<Is...>, std::index_sequence<Js...>)
+      {
+        using content_type = std::tuple<Ns...>;
+        std::array<edge, edge_num> res{};
+        std::size_t pos = 0;
+        (append_edges(res, pos, topology_impl<Ns>::edges, helper::offset_of(Is)), ...);
+        (
+          append_links(
+            res, pos,
+            topology_impl<std::tuple_element_t<Js, content_type>>::lasts, helper::offset_of(Js),
+            topology_impl<std::tuple_element_t<Js + 1, content_type>>::heads, helper::offset_of(Js + 1)
+          ), ...
+        );
+        return res;
+      }
+      static constexpr auto make_lasts()
+      {
+        std::array<std::size_t, last_type::lasts.size()> res{};
+        std::size_t pos = 0;
+        append_indices(res, pos, last_type::lasts, helper::offset_of(sizeof...(Ns) - 1));
+        return res;
+      }
+    public:
+      static constexpr std::size_t node_num = (Ns::node_num + ...);
+      static constexpr auto heads = first_type::heads;
+      static constexpr auto lasts = make_lasts();
+      static constexpr auto edges = make_edges(std::index_sequence_for<Ns...>{}, std::make_index_sequence<sizeof...(Ns) - 1>{});
+    };
+
+    template <typename Node, typename... Ns>
+    struct composite_topology_helper<Node, or_node_tag, std::tuple<Ns...>>
+    {
+    private:
+      using helper = composite_node_helper<std::tuple<Ns...>>;
+      static constexpr std::size_t edge_num = (topology_impl<Ns>::edges.size() + ...);
+      template <std::size_t... Is>
+      static constexpr auto make_heads(std::index_sequence<Is...>)
+      {
+        std::array<std::size_t, (topology_impl<Ns>::heads.size() + ...)> res{};
+        std::size_t pos = 0;
+        (append_indices(res, pos, topology_impl<Ns>::heads, helper::offset_of(Is)), ...);
+        return res;
+      }
+      template <std::size_t... Is>
+      static constexpr auto make_lasts(std::index_sequence<Is...>)
+      {
+        std::array<std::size_t, (topology_impl<Ns>::lasts.size() + ...)> res{};
+        std::size_t pos = 0;
+        (append_indices(res, pos, topology_impl<Ns>::lasts, helper::offset_of(Is)), ...);
+        return res;
+      }
+      template <std::size_t... Is>
+      static constexpr auto make_edges(std::index_sequence<Is...>)
+      {
+        std::array<edge, edge_num> res{};
+        std::size_t pos = 0;
+        (append_edges(res, pos, topology_impl<Ns>::edges, helper::offset_of(Is)), ...);
+        return res;
+      }
+    public:
+      static constexpr std::size_t node_num = (Ns::node_num + ...);
+      static constexpr auto heads = make_heads(std::index_sequence_for<Ns...>{});
+      static constexpr auto lasts = make_lasts(std::index_sequence_for<Ns...>{});
+      static constexpr auto edges = make_edges(std::index_sequence_for<Ns...>{});
+    };
+
+    // successors of every single node in compressed sparse row form,
+    // the successors of node i are successors[successor_offsets[i]] ... successors[successor_offsets[i + 1] - 1]
+    template <typename Graph>
+    struct successor_table
+    {
+    private:
+      using topology_type = topology_impl<Graph>;
+    public:
+      // holds any node index, edge count or offset of the graph
+      using index_type = node_index_t<(topology_type::node_num > topology_type::edges.size() ? topology_type::node_num : topology_type::edges.size())>;
+    private:
+      static constexpr auto make_offsets()
+      {
+        std::array<index_type, topology_type::node_num + 1> res{};
+        for (auto e: topology_type::edges)
+          ++res[e.from + 1];
+        for (std::size_t i = 0; i < topology_type::node_num; ++i)
+          res[i + 1] += res[i];
+        return res;
+      }
+    public:
+      static constexpr auto successor_offsets = make_offsets();
+    private:
+      static constexpr auto make_successors()
+      {
+        std::array<index_type, topology_type::edges.size()> res{};
+        auto pos = successor_offsets;
+        for (auto e: topology_type::edges)
+          res[pos[e.from]++] = static_cast<index_type>(e.to);
+        return res;
+      }
+      static constexpr auto make_predecessor_counts()
+      {
+        std::array<index_type, topology_type::node_num> res{};
+        for (auto e: topology_type::edges)
+          ++res[e.to];
+        return res;
+      }
+    public:
+      static constexpr auto successors = make_successors();
+      static constexpr auto predecessor_counts = make_predecessor_counts();
+    private:
+      static constexpr auto make_predecessor_offsets()
+      {
+        std::array<index_type, topology_type::node_num + 1> res{};
+        for (std::size_t i = 0; i < topology_type::node_num; ++i)
+          res[i + 1] = res[i] + predecessor_counts[i];
+        return res;
+      }
+    public:
+      // predecessors in the same form, the predecessors of a node are in increasing order
+      static constexpr auto predecessor_offsets = make_predecessor_offsets();
+    private:
+      static constexpr auto make_predecessors()
+      {
+        std::array<index_type, topology_type::edges.size()> res{};
+        auto pos = predecessor_offsets;
+        for (std::size_t i = 0; i < topology_type::node_num; ++i)
+          for (auto j = successor_offsets[i]; j < successor_offsets[i + 1]; ++j)
+            res[pos[successors[j]]++] = static_cast<index_type>(i);
+        return res;
+      }
+    public:
+      static constexpr auto predecessors = make_predecessors();
+    };
+
+    // the transitive successors of every node (the node included) as bitsets, computed at compile time
+    template <typename Graph>
+    struct reachability_table
+    {
+      static constexpr std::size_t word_bits = 64;
+      static constexpr std::size_t word_num = (Graph::node_num + word_bits - 1) / word_bits;
+      using bitset_type = std::array<std::uint64_t, word_num>;
+    private:
+      using table = successor_table<Graph>;
+      static constexpr auto make_reachable()
+      {
+        std::array<bitset_type, Graph::node_num> res{};
+        // every successor has a larger index, so the successors are complete when a node is reached from the back
+        for (auto i = Graph::node_num; i-- > 0;)
+        {
+          res[i][i / word_bits] |= std::uint64_t{1} << (i % word_bits);
+          for (auto j = table::successor_offsets[i]; j < table::successor_offsets[i + 1]; ++j)
+            for (std::size_t w = 0; w < word_num; ++w)
+              res[i][w] |= res[table::successors[j]][w];
+        }
+        return res;
+      }
+    public:
+      static constexpr auto reachable = make_reachable();
+      static constexpr bool reaches(std::size_t from, std::size_t to) { return (reachable[from][to / word_bits] >> (to % word_bits)) & 1; }
+    };
+
+    template <typename Graph, std::size_t I, typename Seq>
+    struct successors_impl;
+    template <typename Graph, std::size_t I, std::size_t... Js>
+    struct successors_impl<Graph, I, std::index_sequence<Js...>>
+    {
+      using table = successor_table<Graph>;
+      using type = std::index_sequence<table::successors[table::successor_offsets[I] + Js]...>;
+    };
+  }
+
+  // the whole topology of Graph as read-only static data in compressed sparse row form, indexed by the flat node index.
+  // the successors of node i are successors[offsets[i]] ... successors[offsets[i + 1] - 1], the predecessors likewise.
+  // the entries are index_type, the narrowest unsigned type for the size of the graph (see node_index_t).
+  template <typename Graph>
+  struct adjacency
+  {
+  private:
+    using table = detail::successor_table<Graph>;
+  public:
+    using graph_type = Graph;
+    using index_type = typename table::index_type;
+    static constexpr std::size_t node_num = Graph::node_num;
+    static constexpr std::size_t edge_num = table::successors.size();
+  private:
+    static constexpr auto make_out_degree()
+    {
+      std::array<index_type, node_num> res{};
+      for (std::size_t i = 0; i < node_num; ++i)
+        res[i] = table::successor_offsets[i + 1] - table::successor_offsets[i];
+      return res;
+    }
+  public:
+    static constexpr const std::array<index_type, node_num + 1>& offsets = table::successor_offsets;
+    static constexpr const std::array<index_type, edge_num>& successors = table::successors;
+    static constexpr const std::array<index_type, node_num + 1>& predecessor_offsets = table::predecessor_offsets;
+    static constexpr const std::array<index_type, edge_num>& predecessors = table::predecessors;
+    static constexpr const std::array<index_type, node_num>& in_degree = table::predecessor_counts;
+    static constexpr std::array<index_type, node_num> out_degree = make_out_degree();
+    static constexpr span<const index_type> successors_of(std::size_t i) { return span<const index_type>(successors.data() + offsets[i], out_degree[i]); }
+    static constexpr span<const index_type> predecessors_of(std::size_t i) { return span<const index_type>(predecessors.data() + predecessor_offsets[i], in_degree[i]); }
+  };
+
+  // the flat indices of the successors of the I-th single node of Graph.
+  // these are the links of index_link_tag nodes, they depend only on the graph type and never need construct_connection().
+  template <typename Graph, std::size_t I>
+  struct successors:
+    detail::successors_impl<
+      Graph,
+      I,
+      std::make_index_sequence<
+        detail::successor_table<Graph>::successor_offsets[I + 1] - detail::successor_table<Graph>::successor_offsets[I]
+      >
+    > {};
+  template <typename Graph, std::size_t I>
+  using successors_t = typename successors<Graph, I>::type;
+
+  namespace detail
+  {
+    template <typename Graph, std::size_t I, typename Seq>
+    struct predecessors_impl;
+    template <typename Graph, std::size_t I, std::size_t... Js>
+    struct predecessors_impl<Graph, I, std::index_sequence<Js...>>
+    {
+      using table = successor_table<Graph>;
+      using type = std::index_sequence<table::predecessors[table::predecessor_offsets[I] + Js]...>;
+    };
+  }
+
+  // the flat indices of the predecessors of the I-th single node of Graph, in increasing order
+  template <typename Graph, std::size_t I>
+  struct predecessors: detail::predecessors_impl<Graph, I, std::make_index_sequence<detail::successor_table<Graph>::predecessor_counts[I]>> {};
+  template <typename Graph, std::size_t I>
+  using predecessors_t = typename predecessors<Graph, I>::type;
+
+  namespace detail
+  {
+    template <typename Graph, typename Seq>
+    struct head_indices_impl;
+    template <typename Graph, std::size_t... Js>
+    struct head_indices_impl<Graph, std::index_sequence<Js...>>
+    {
+      using type = std::index_sequence<topology_impl<Graph>::heads[Js]...>;
+    };
+  }
+
+  // the flat indices of the single nodes of Graph which have no predecessor
+  template <typename Graph>
+  struct head_indices: detail::head_indices_impl<Graph, std::make_index_sequence<detail::topology_impl<Graph>::heads.size()>> {};
+  template <typename Graph>
+  using head_indices_t = typename head_indices<Graph>::type;
+
+  // structural queries over a graph type, all computed at compile time
+
+  // whether there is a path from the I-th to the J-th single node, a node reaches itself
+  template <typename Graph, std::size_t I, std::size_t J>
+  struct reachable: std::bool_constant<detail::reachability_table<Graph>::reaches(I, J)> {};
+  template <typename Graph, std::size_t I, std::size_t J>
+  constexpr bool reachable_v = reachable<Graph, I, J>::value;
+
+  namespace detail
+  {
+    template <typename Graph>
+    struct graph_measures
+    {
+    private:
+      using adj = adjacency<Graph>;
+      static constexpr std::size_t node_num = Graph::node_num;
+      static constexpr auto make_path_counts()
+      {
+        // the number of paths from a head node to every node
+        std::array<std::size_t, node_num> res{};
+        for (std::size_t i = 0; i < node_num; ++i)
+        {
+          if (adj::in_degree[i] == 0)
+            res[i] = 1;
+          for (auto p: adj::predecessors_of(i))
+            res[i] += res[p];
+        }
+        return res;
+      }
+      static constexpr std::size_t make_path_count()
+      {
+        constexpr auto counts = make_path_counts();
+        std::size_t res = 0;
+        for (std::size_t i = 0; i < node_num; ++i)
+          if (adj::out_degree[i] == 0)
+            res += counts[i];
+        return res;
+      }
+      static constexpr auto make_levels()
+      {
+        // the number of nodes on the longest path from a head node to the node, minus one
+        std::array<std::size_t, node_num> res{};
+        for (std::size_t i = 0; i < node_num; ++i)
+          for (auto p: adj::predecessors_of(i))
+            if (res[i] < res[p] + 1)
+              res[i] = res[p] + 1;
+        return res;
+      }
+    public:
+      static constexpr std::size_t path_count = make_path_count();
+      static constexpr auto levels = make_levels();
+    private:
+      static constexpr std::size_t make_depth()
+      {
+        std::size_t res = 0;
+        for (auto level: levels)
+          if (res < level + 1)
+            res = level + 1;
+        return res;
+      }
+      static constexpr auto make_topological_order()
+      {
+        std::array<std::size_t, node_num> res{};
+        std::size_t pos = 0;
+        for (std::size_t level = 0; pos < node_num; ++level)
+          for (std::size_t i = 0; i < node_num; ++i)
+            if (levels[i] == level)
+              res[pos++] = i;
+        return res;
+      }
+      using reachability = reachability_table<Graph>;
+      static constexpr bool try_match(std::size_t from, std::array<std::size_t, node_num>& match, std::array<bool, node_num>& seen)
+      {
+        for (std::size_t to = 0; to < node_num; ++to)
+        {
+          if (to == from || seen[to] || !reachability::reaches(from, to))
+            continue;
+          seen[to] = true;
+          if (match[to] == node_num || try_match(match[to], match, seen))
+          {
+            match[to] = from;
+            return true;
+          }
+        }
+        return false;
+      }
+      static constexpr std::size_t make_width()
+      {
+        // the largest set of nodes without a path between any two of them.
+        // by Dilworth's theorem it is node_num minus a maximum matching between the nodes and their transitive successors
+        std::array<std::size_t, node_num> match{};
+        for (auto& m: match)
+          m = node_num;
+        std::size_t matched = 0;
+        for (std::size_t from = 0; from < node_num; ++from)
+        {
+          std::array<bool, node_num> seen{};
+          if (try_match(from, match, seen))
+            ++matched;
+        }
+        return node_num - matched;
+      }
+    public:
+      static constexpr std::size_t depth = make_depth();
+      static constexpr std::size_t width = make_width();
+      static constexpr auto topological_order = make_topological_order();
+    };
+
+    template <typename Graph, typename Seq>
+    struct topological_order_impl;
+    template <typename Graph, std::size_t... Is>
+    struct topological_order_impl<Graph, std::index_sequence<Is...>>
+    {
+      using type = std::index_sequence<graph_measures<Graph>::topological_order[Is]...>;
+    };
+  }
+
+  // the number of paths from a head node to a last node
+  template <typename Graph>
+  struct path_count: std::integral_constant<std::size_t, detail::graph_measures<Graph>::path_count> {};
+  template <typename Graph>
+  constexpr std::size_t path_count_v = path_count<Graph>::value;
+
+  // the number of single nodes on the longest path, the length of any sequential schedule of the levels
+  template <typename Graph>
+  struct depth: std::integral_constant<std::size_t, detail::graph_measures<Graph>::depth> {};
+  template <typename Graph>
+  constexpr std::size_t depth_v = depth<Graph>::value;
+
+  // the largest number of single nodes without a path between any two of them, the most nodes that can ever run at the same time
+  template <typename Graph>
+  struct width: std::integral_constant<std::size_t, detail::graph_measures<Graph>::width> {};
+  template <typename Graph>
+  constexpr std::size_t width_v = width<Graph>::value;
+
+  // the flat indices ordered by level (the longest distance from a head node), in increasing index within a level.
+  // the nodes of a level are independent of each other. the flat index order itself is also a topological order.
+  template <typename Graph>
+  struct topological_order: detail::topological_order_impl<Graph, std::make_index_sequence<Graph::node_num>> {};
+  template <typename Graph>
+  using topological_order_t = typename topological_order<Graph>::type;
+
+  namespace detail
+  {
+    template <typename Graph, std::size_t... Js>
+    constexpr auto successor_nodes_impl(Graph& graph, std::index_sequence<Js...>)
+    {
+      return std::tie(node_at<Js>(graph)...);
+    }
+  }
+
+  // a tuple of references to the successors of the I-th single node
+  template <std::size_t I, typename Graph>
+  constexpr auto successor_nodes(Graph& graph)
+  {
+    return detail::successor_nodes_impl(graph, successors_t<std::remove_const_t<Graph>, I>{});
+  }
+}
+
+#endif
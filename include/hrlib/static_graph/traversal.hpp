@@ -0,0 +1,121 @@
+#ifndef HRLIB_STATIC_GRAPH_TRAVERSAL
+#define HRLIB_STATIC_GRAPH_TRAVERSAL
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+namespace hrlib::static_graph
+{
+  // traversals over the single nodes of a graph, usable in constant expressions and at runtime.
+  // the visitor is called as visitor(node, index) with the node itself and its flat index.
+  // visited nodes are marked in a side array with the number of the current traversal (the epoch),
+  // so the nodes need no is_visited flag and starting a new traversal is O(1).
+  template <typename Graph>
+  class graph_traversal
+  {
+  public:
+    using graph_type = Graph;
+    static constexpr std::size_t node_num = Graph::node_num;
+  private:
+    using adj = adjacency<Graph>;
+    std::array<std::uint32_t, node_num> marks{};
+    std::uint32_t epoch = 0;
+
+    constexpr void start()
+    {
+      if (++epoch == 0)
+      { // the epoch wrapped around, the old marks could be taken for the new epoch
+        for (auto& mark: marks)
+          mark = 0;
+        epoch = 1;
+      }
+    }
+    constexpr bool mark(std::size_t index)
+    {
+      if (marks[index] == epoch)
+        return false;
+      marks[index] = epoch;
+      return true;
+    }
+
+    template <typename G, typename Visitor, std::size_t I>
+    static constexpr void visit_node(G& graph, Visitor& visitor) { visitor(node_at<I>(graph), I); }
+    template <typename G, typename Visitor, std::size_t... Is>
+    static constexpr std::array<void (*)(G&, Visitor&), node_num> make_dispatch_table(std::index_sequence<Is...>)
+    {
+      return {{&visit_node<G, Visitor, Is>...}};
+    }
+    template <typename G, typename Visitor>
+    static constexpr void visit(G& graph, Visitor& visitor, std::size_t index)
+    {
+      constexpr auto table = make_dispatch_table<G, Visitor>(std::make_index_sequence<node_num>{});
+      table[index](graph, visitor);
+    }
+  public:
+    constexpr graph_traversal() = default;
+    // depth first in pre-order from every node without a predecessor, successors in the order of the graph expression
+    template <typename G, typename Visitor>
+    constexpr void dfs(G& graph, Visitor&& visitor)
+    {
+      static_assert(std::is_same_v<std::remove_const_t<G>, Graph>);
+      start();
+      std::array<std::size_t, adj::edge_num + node_num> stack{};
+      std::size_t size = 0;
+      for (auto i = node_num; i-- > 0;)
+        if (adj::in_degree[i] == 0)
+          stack[size++] = i;
+      while (size != 0)
+      {
+        const auto index = stack[--size];
+        if (!mark(index))
+          continue;
+        visit(graph, visitor, index);
+        for (auto i = adj::offsets[index + 1]; i-- > adj::offsets[index];)
+          if (marks[adj::successors[i]] != epoch)
+            stack[size++] = adj::successors[i];
+      }
+    }
+    // breadth first from every node without a predecessor
+    template <typename G, typename Visitor>
+    constexpr void bfs(G& graph, Visitor&& visitor)
+    {
+      static_assert(std::is_same_v<std::remove_const_t<G>, Graph>);
+      start();
+      std::array<std::size_t, node_num> queue{};
+      std::size_t first = 0, last = 0;
+      for (std::size_t i = 0; i < node_num; ++i)
+        if (adj::in_degree[i] == 0 && mark(i))
+          queue[last++] = i;
+      while (first != last)
+      {
+        const auto index = queue[first++];
+        visit(graph, visitor, index);
+        for (auto successor: adj::successors_of(index))
+          if (mark(successor))
+            queue[last++] = successor;
+      }
+    }
+    // every node after all of its predecessors, the flat index order is a topological order
+    template <typename G, typename Visitor>
+    constexpr void topological_for_each(G& graph, Visitor&& visitor) const
+    {
+      static_assert(std::is_same_v<std::remove_const_t<G>, Graph>);
+      for (std::size_t i = 0; i < node_num; ++i)
+        visit(graph, visitor, i);
+    }
+  };
+
+  template <typename G, typename Visitor>
+  constexpr void dfs(G& graph, Visitor&& visitor) { graph_traversal<std::remove_const_t<G>>{}.dfs(graph, std::forward<Visitor>(visitor)); }
+  template <typename G, typename Visitor>
+  constexpr void bfs(G& graph, Visitor&& visitor) { graph_traversal<std::remove_const_t<G>>{}.bfs(graph, std::forward<Visitor>(visitor)); }
+  template <typename G, typename Visitor>
+  constexpr void topological_for_each(G& graph, Visitor&& visitor) { graph_traversal<std::remove_const_t<G>>{}.topological_for_each(graph, std::forward<Visitor>(visitor)); }
+}
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef HRLIB_STATIC_GRAPH_WORK_STEALING_POOL
+#define HRLIB_STATIC_GRAPH_WORK_STEALING_POOL
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+
+namespace hrlib::static_graph
+{
+  // a thread pool in which every worker owns a task queue.
+  // a worker pops the tasks it pushed itself from the back of its own queue (LIFO, cache friendly)
+  // and steals from the front of the other queues when its own queue is empty.
+  // threads which are not workers of the pool push into a shared queue and can help with run_one().
+  class work_stealing_pool
+  {
+  public:
+    struct task
+    {
+      void (*fn)(void*, std::size_t);
+      void* context;
+      std::size_t index;
+    };
+  private:
+    struct task_queue
+    {
+      std::mutex mutex;
+      std::deque<task> tasks;
+    };
+    std::vector<std::unique_ptr<task_queue>> queues; // one per worker, the last one is shared by the other threads
+    std::vector<std::thread> workers;
+    // the tasks pushed and not taken yet. a task is in its queue before it is counted, so it can be taken first
+    // and the count can be below zero for a moment
+    std::atomic<std::ptrdiff_t> queued{0};
+    std::atomic<bool> stopped{false};
+    // push() locks sleep_mutex and notifies only when a worker sleeps. a worker counts itself before it checks queued
+    // and push() counts the task before it checks sleepers, both seq_cst, so one of them always sees the other
+    std::atomic<std::size_t> sleepers{0};
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+
+    struct worker_id
+    {
+      const work_stealing_pool* pool = nullptr;
+      std::size_t index = 0;
+    };
+    static worker_id& current_worker()
+    {
+      static thread_local worker_id id;
+      return id;
+    }
+    std::size_t own_queue_index() const
+    {
+      const auto& id = current_worker();
+      return id.pool == this ? id.index : workers.size();
+    }
+    bool pop(std::size_t queue_index, task& t)
+    {
+      auto& queue = *queues[queue_index];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty())
+        return false;
+      t = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+    bool steal(std::size_t queue_index, task& t)
+    {
+      auto& queue = *queues[queue_index];
+      std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+      if (!lock.owns_lock() || queue.tasks.empty())
+        return false;
+      t = queue.tasks.front();
+      queue.tasks.pop_front();
+      return true;
+    }
+    bool try_get(task& t)
+    {
+      if (queued.load(std::memory_order_acquire) <= 0)
+        return false;
+      const auto own = own_queue_index();
+      if (pop(own, t))
+        return true;
+      for (std::size_t i = 1; i < queues.size(); ++i)
+        if (steal((own + i) % queues.size(), t))
+          return true;
+      return false;
+    }
+    void execute(const task& t)
+    {
+      queued.fetch_sub(1, std::memory_order_acq_rel);
+      t.fn(t.context, t.index);
+    }
+    void worker_loop(std::size_t index)
+    {
+      current_worker() = worker_id{this, index};
+      while (true)
+      {
+        task t;
+        if (try_get(t))
+        {
+          execute(t);
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleepers.fetch_add(1);
+        sleep_cv.wait(lock, [this]{ return stopped.load() || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+        if (stopped.load() && queued.load() <= 0)
+          return;
+      }
+    }
+  public:
+    explicit work_stealing_pool(std::size_t thread_num = std::thread::hardware_concurrency())
+    {
+      if (thread_num == 0)
+        thread_num = 1;
+      for (std::size_t i = 0; i < thread_num + 1; ++i)
+        queues.push_back(std::make_unique<task_queue>());
+      workers.reserve(thread_num);
+      for (std::size_t i = 0; i < thread_num; ++i)
+        workers.emplace_back([this, i]{ worker_loop(i); });
+    }
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+    ~work_stealing_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopped = true;
+      }
+      sleep_cv.notify_all();
+      for (auto& worker: workers)
+        worker.join();
+    }
+    std::size_t size() const noexcept { return workers.size(); }
+    void push(task t)
+    {
+      {
+        auto& queue = *queues[own_queue_index()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(t);
+      }
+      queued.fetch_add(1);
+      if (sleepers.load() == 0)
+        return;
+      // a worker which has counted itself holds sleep_mutex until it waits, so the notification cannot come before the wait
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+      }
+      sleep_cv.notify_one();
+    }
+    // executes one queued task on the calling thread, returns false if there is nothing to do
+    bool run_one()
+    {
+      task t;
+      if (!try_get(t))
+        return false;
+      execute(t);
+      return true;
+    }
+  };
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <hrlib/error_handling/result.hpp>
 #include <string>
+#include <memory>
+#include <type_traits>
 #include <boost/type_index.hpp>
 #include <exception>
 #include <boost/test/unit_test.hpp>
@@ -10,6 +12,17 @@
 using namespace hrlib;
 using namespace hrlib::error_handling;
 
+struct NotFound {};
+enum class Color : unsigned char { red, green, invalid = 255 };
+
+namespace hrlib::error_handling::result {
+    template <>
+    struct Niche<Color> {
+        static Color niche_value() noexcept { return Color::invalid; }
+        static bool is_niche(const Color& color) noexcept { return color == Color::invalid; }
+    };
+}
+
 BOOST_AUTO_TEST_SUITE(result_test)
     BOOST_AUTO_TEST_CASE(result_methods) {
         auto result1 = Result<int>(result::Ok(1));
@@ -110,5 +123,63 @@ BOOST_AUTO_TEST_SUITE(result_test)
                               [](const std::runtime_error&){return true;});
 
     }
+    BOOST_AUTO_TEST_CASE(result_storage) {
+        //a one byte discriminator next to the values, trivial copy and destruction when the values have them
+        static_assert(sizeof(Result<char, char>) == 2);
+        static_assert(sizeof(Result<int, bool>) == sizeof(int) * 2);
+        static_assert(std::is_trivially_copyable_v<Result<int, int>>);
+        static_assert(std::is_trivially_destructible_v<Result<int, int>>);
+        static_assert(!std::is_trivially_copyable_v<Result<std::string, int>>);
+        //a move-only value makes the result move-only
+        static_assert(!std::is_copy_constructible_v<Result<std::unique_ptr<int>, std::string>>);
+        static_assert(!std::is_copy_assignable_v<Result<std::unique_ptr<int>, std::string>>);
+        static_assert(std::is_move_constructible_v<Result<std::unique_ptr<int>, std::string>>);
+        static_assert(std::is_move_assignable_v<Result<std::unique_ptr<int>, std::string>>);
+        static_assert(std::is_nothrow_move_constructible_v<Result<std::unique_ptr<int>, std::string>>);
+        //an assignment between the alternatives destroys one before it moves in the other, so it needs nothrow moves
+        static_assert(std::is_nothrow_move_constructible_v<result::Ok<std::string>> && std::is_nothrow_move_constructible_v<result::Err<std::string>>);
+        static_assert(sizeof(Result<std::unique_ptr<int>, std::string>) == sizeof(Result<int*, std::string>));
+        //the error state is a niche of the ok value when the error value is empty
+        static_assert(sizeof(Result<int*, NotFound>) == sizeof(int*));
+        static_assert(sizeof(Result<Color, NotFound>) == 1);
+        static_assert(std::is_trivially_copyable_v<Result<int*, NotFound>>);
+        static_assert(sizeof(Result<char*, NotFound>) > sizeof(char*));
+
+        int x = 1;
+        auto result1 = Result<int*, NotFound>(result::Ok<int*>(&x));
+        BOOST_CHECK(result1);
+        BOOST_CHECK_EQUAL(result1.get_ok(), &x);
+        auto result2 = Result<int*, NotFound>(result::Ok<int*>(nullptr));
+        BOOST_CHECK(result2);
+        BOOST_CHECK(result2.get_ok() == nullptr);
+        auto result3 = Result<int*, NotFound>(result::Err(NotFound{}));
+        BOOST_CHECK(!result3);
+        BOOST_CHECK_EXCEPTION(result3.get_ok(),
+                              std::bad_variant_access,
+                              [](const std::bad_variant_access&){return true;});
+        BOOST_CHECK(!result3.map([](int* p){ return p; }));
+        BOOST_CHECK(result3.match([](auto&& val){ return type_traits::is_match_template_v<result::Err, std::decay_t<decltype(val)>>; }));
+        //the made Err is passed as an lvalue or an rvalue like a held one
+        BOOST_CHECK(result3.match([](auto& val){ return std::is_same_v<decltype(val), const result::Err<NotFound>&>; }));
+        BOOST_CHECK((Result<int*, NotFound>(result::Err(NotFound{})).match(
+            [](auto&& val){ return std::is_same_v<decltype(val), result::Err<NotFound>&&>; })));
+        BOOST_CHECK((Result<int*, NotFound>(result::Ok<int*>(&x)).match(
+            [](auto&& val){ return std::is_same_v<decltype(val), result::Ok<int*>&&>; })));
+        result3 = result1;
+        BOOST_CHECK_EQUAL(*result3.get_ok(), 1);
+        BOOST_CHECK(!(Result<Color, NotFound>(result::Err(NotFound{}))));
+        BOOST_CHECK((Result<Color, NotFound>(result::Ok(Color::green)).get_ok() == Color::green));
+
+        //assignment between the alternatives
+        auto result4 = Result<std::string, std::string>(result::Ok(std::string("ok")));
+        auto result5 = Result<std::string, std::string>(result::Err(std::string("err")));
+        result4 = result5;
+        BOOST_CHECK(!result4);
+        BOOST_CHECK_EQUAL(result4.get_err(), std::string("err"));
+        result5 = Result<std::string, std::string>(result::Ok(std::string("ok")));
+        BOOST_CHECK_EQUAL(result5.get_ok(), std::string("ok"));
+        auto result6 = std::move(result5);
+        BOOST_CHECK_EQUAL(result6.get_ok(), std::string("ok"));
+    }
 BOOST_AUTO_TEST_SUITE_END()
 
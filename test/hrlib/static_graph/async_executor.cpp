@@ -0,0 +1,161 @@
+#include <type_traits>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/async_executor.hpp>
+
+template <std::size_t N>
+struct context
+{
+  int ticket = 0;
+  int stamps[N] = {};
+  int polls = 0;
+};
+
+// stands for a read which completes after a number of polls
+template <std::size_t N>
+struct pending_read
+{
+  context<N>* ctx;
+  std::size_t id;
+  int remaining;
+  bool poll() { ++ctx->polls; return remaining-- <= 0; }
+  void complete() { ctx->stamps[id] = ++ctx->ticket; }
+};
+
+// stands for a read completed by another thread, which notifies the executor or not
+template <bool Notifying>
+struct io_read
+{
+  std::atomic<bool>* done;
+  int* polls;
+  std::thread* device;
+  bool poll() { ++*polls; return done->load(std::memory_order_acquire); }
+  void complete() { device->join(); }
+};
+template <>
+struct io_read<true>: io_read<false>
+{
+  void set_notifier(hrlib::static_graph::async_notifier notifier)
+  {
+    *device = std::thread([done = done, notifier]{
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      done->store(true, std::memory_order_release);
+      notifier.notify();
+    });
+  }
+};
+
+template <bool Notifying, typename Next = hrlib::static_graph::terminal_node>
+struct io_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr io_node<Notifying, NextNodeType> copy() const { return {}; }
+  std::atomic<bool> done{false};
+  int polls = 0;
+  std::thread device;
+  io_node() = default;
+  io_node(io_node&&) noexcept: base_type() {}
+  template <typename Context>
+  io_read<Notifying> run(Context&)
+  {
+    if constexpr (Notifying)
+      return {{&done, &polls, &device}};
+    else
+    {
+      device = std::thread([this]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        done.store(true, std::memory_order_release);
+      });
+      return {&done, &polls, &device};
+    }
+  }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct stamp_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr stamp_node<NextNodeType> copy() const { return stamp_node<NextNodeType>{id}; }
+  std::size_t id = 0;
+  constexpr stamp_node(std::size_t id): base_type(), id(id) {}
+  template <typename Context>
+  void run(Context& ctx) { ctx.stamps[id] = ++ctx.ticket; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct read_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr read_node<NextNodeType> copy() const { return read_node<NextNodeType>{id, latency}; }
+  std::size_t id = 0;
+  int latency = 0;
+  constexpr read_node(std::size_t id, int latency): base_type(), id(id), latency(latency) {}
+  template <std::size_t N>
+  pending_read<N> run(context<N>& ctx) { return {&ctx, id, latency}; }
+};
+
+template <typename Graph, std::size_t N>
+bool check_order(const context<N>& ctx)
+{
+  using adj = hrlib::static_graph::adjacency<Graph>;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    if (ctx.stamps[i] == 0)
+      return false;
+    for (auto successor: adj::successors_of(i))
+      if (ctx.stamps[i] >= ctx.stamps[successor])
+        return false;
+  }
+  return true;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  // 0 -> {1, 4}, 1 -> 2 -> 3, 4 -> 5 -> 6, {3, 6} -> 7
+  auto graph = stamp_node<>{0} + ((read_node<>{1, 5} + stamp_node<>{2} + stamp_node<>{3}) | (stamp_node<>{4} + read_node<>{5, 0} + stamp_node<>{6})) + stamp_node<>{7};
+  using graph_type = decltype(graph);
+  async_executor<graph_type> executor;
+  for (int i = 0; i < 3; ++i)
+  {
+    context<graph_type::node_num> ctx;
+    executor.run(graph, ctx);
+    assert(check_order<graph_type>(ctx));
+    // the other branch runs while the slow read is pending
+    assert(ctx.stamps[6] < ctx.stamps[1]);
+    // a read which is ready at once does not hold up its path
+    assert(ctx.stamps[5] + 1 == ctx.stamps[6]);
+    assert(ctx.polls == 1 + 6);
+  }
+
+  // a graph without pending operations runs in topological order
+  auto sync_graph = stamp_node<>{0} + (stamp_node<>{1} | stamp_node<>{2}) + stamp_node<>{3};
+  context<4> ctx;
+  async_executor<decltype(sync_graph)>{}.run(sync_graph, ctx);
+  assert(ctx.stamps[0] == 1 && ctx.stamps[1] == 2 && ctx.stamps[2] == 3 && ctx.stamps[3] == 4);
+
+  // a notifying operation is polled twice before the thread sleeps and once after it has notified
+  {
+    auto io_graph = stamp_node<>{0} + io_node<true>{} + stamp_node<>{2};
+    context<3> io_ctx;
+    async_executor<decltype(io_graph)>{}.run(io_graph, io_ctx);
+    assert(io_ctx.stamps[0] == 1 && io_ctx.stamps[2] == 2);
+    assert(node_at<1>(io_graph).polls == 3);
+  }
+  // the other operations are polled with a growing timeout, not in a loop for the whole wait
+  {
+    auto io_graph = stamp_node<>{0} + io_node<false>{} + stamp_node<>{2};
+    context<3> io_ctx;
+    async_executor<decltype(io_graph)>{}.run(io_graph, io_ctx);
+    assert(io_ctx.stamps[2] == 2);
+    assert(node_at<1>(io_graph).polls < 100);
+  }
+  return 0;
+}
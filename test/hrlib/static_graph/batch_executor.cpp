@@ -0,0 +1,135 @@
+#include <type_traits>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <memory>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/batch_executor.hpp>
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct add_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  add_node<NextNodeType> copy() const { return add_node<NextNodeType>{value}; }
+  int value = 0;
+  add_node(int val): base_type(), value(val) {}
+  int process(int in) const { return in + value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct scale_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  scale_node<NextNodeType> copy() const { return scale_node<NextNodeType>{value}; }
+  int value = 0;
+  std::size_t batch_calls = 0;
+  scale_node(int val): base_type(), value(val) {}
+  int process(int in) const { return in * value; }
+  void process_batch(hrlib::static_graph::span<const int> in, hrlib::static_graph::span<int> out)
+  {
+    ++batch_calls;
+    for (std::size_t i = 0; i < in.size(); ++i)
+      out[i] = in[i] * value;
+  }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct to_string_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  to_string_node<NextNodeType> copy() const { return {}; }
+  std::string process(int in) const { return std::to_string(in); }
+};
+
+// takes the ownership of the records of its block
+template <typename Next = hrlib::static_graph::terminal_node>
+struct collect_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  collect_node<NextNodeType> copy() const { return {}; }
+  std::vector<std::string> strings;
+  std::size_t batch_calls = 0;
+  void process(std::string&& in) { strings.push_back(std::move(in)); }
+  void process_batch(hrlib::static_graph::span<std::string> in)
+  {
+    ++batch_calls;
+    for (auto& s: in)
+      strings.push_back(std::move(s));
+  }
+};
+
+// an input record without default constructor or assignment
+struct boxed
+{
+  int value;
+  explicit boxed(int value): value(value) {}
+  boxed(const boxed&) = default;
+  boxed& operator=(const boxed&) = delete;
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct unbox_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  unbox_node<NextNodeType> copy() const { return {}; }
+  int process(const boxed& in) const { return in.value; }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  std::vector<int> records(10);
+  std::iota(records.begin(), records.end(), 0);
+
+  auto n1 = add_node<>{1} + scale_node<>{2} + add_node<>{100};
+  batch_executor<decltype(n1), int, 4> e1{};
+  std::vector<int> out1;
+  std::size_t blocks = 0;
+  e1.run(n1, records, [&](span<int> block){ ++blocks; out1.insert(out1.end(), block.begin(), block.end()); });
+  assert(blocks == 3);
+  assert(std::get<1>(n1.get_nodes()).batch_calls == 3);
+  for (int i = 0; i < 10; ++i)
+    assert(out1[i] == (i + 1) * 2 + 100);
+
+  // a node after an or_node processes the block of every branch, the outputs are the same as dataflow_executor
+  auto n2 = add_node<>{1} + (scale_node<>{10} | (add_node<>{20} + scale_node<>{3})) + add_node<>{4000};
+  using n2_type = decltype(n2);
+  static_assert(detail::batch_table<n2_type>::multiplicities[4] == 2);
+  batch_executor<n2_type, int, 4> e2{};
+  std::vector<int> batch_out, stream_out;
+  e2.run(n2, records, [&](span<int> block){ batch_out.insert(batch_out.end(), block.begin(), block.end()); });
+  dataflow_executor<n2_type>{}.run(n2, records, [&](int out){ stream_out.push_back(out); });
+  assert(batch_out.size() == 20);
+  std::sort(batch_out.begin(), batch_out.end());
+  std::sort(stream_out.begin(), stream_out.end());
+  assert(batch_out == stream_out);
+
+  // the last node moves the strings out of the block of its predecessor
+  auto n3 = add_node<>{1} + to_string_node<>{} + collect_node<>{};
+  batch_executor<decltype(n3), int, 8> e3{};
+  e3.run(n3, records);
+  auto& collected = std::get<2>(n3.get_nodes());
+  assert(collected.batch_calls == 2);
+  assert(collected.strings.size() == 10 && collected.strings[0] == "1" && collected.strings[9] == "10");
+
+  auto n4 = add_node<>{1} + add_node<>{2};
+  batch_executor<decltype(n4), int> e4{};
+  std::vector<int> out4;
+  e4.run(n4, std::vector<int>{}, [&](span<int> block){ out4.insert(out4.end(), block.begin(), block.end()); });
+  assert(out4.empty());
+  e4.run(n4, std::vector<int>{5}, [&](span<int> block){ out4.insert(out4.end(), block.begin(), block.end()); });
+  assert((out4 == std::vector<int>{8}));
+
+  auto n5 = unbox_node<>{} + add_node<>{1};
+  batch_executor<decltype(n5), boxed, 2> e5{};
+  std::vector<int> out5;
+  e5.run(n5, std::vector<boxed>{boxed(1), boxed(2), boxed(3)}, [&](span<int> block){ out5.insert(out5.end(), block.begin(), block.end()); });
+  assert((out5 == std::vector<int>{2, 3, 4}));
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <type_traits>
+#include <tuple>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  static_assert(N == Graph::node_num);
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto c1 = value_node<>{1} + value_node<>{2} + value_node<>{3} + value_node<>{4};
+  constexpr auto b1 = make_chain(value_node<>{1}, value_node<>{2}, value_node<>{3}, value_node<>{4});
+  static_assert(std::is_same_v<decltype(c1), decltype(b1)>);
+  static constexpr int ans1[4] = {1, 2, 3, 4};
+  static_assert(check_run(b1, ans1));
+
+  constexpr auto p1 = value_node<>{1} | value_node<>{2} | value_node<>{3};
+  constexpr auto q1 = make_parallel(value_node<>{1}, value_node<>{2}, value_node<>{3});
+  static_assert(std::is_same_v<decltype(p1), decltype(q1)>);
+
+  // nested chains are flattened and or_nodes are rebound as a whole, as operator+ does
+  constexpr auto n1 = value_node<>{1} + (value_node<>{2} + value_node<>{3});
+  constexpr auto n2 = (value_node<>{6} + value_node<>{5}) + value_node<>{4};
+  constexpr auto n3 = (value_node<>{7} + value_node<>{8}) + (value_node<>{9} | value_node<>{10});
+  constexpr auto c2 = n1 + (value_node<>{11} | n3 | value_node<>{12}) + n2;
+  constexpr auto b2 = make_chain(
+    make_chain(value_node<>{1}, value_node<>{2}, value_node<>{3}),
+    make_parallel(value_node<>{11}, make_chain(value_node<>{7}, value_node<>{8}, make_parallel(value_node<>{9}, value_node<>{10})), value_node<>{12}),
+    value_node<>{6},
+    make_chain(value_node<>{5}, value_node<>{4})
+  );
+  static_assert(std::is_same_v<decltype(c2), decltype(b2)>);
+  static constexpr int ans2[12] = {1, 2, 3, 11, 7, 8, 9, 10, 12, 6, 5, 4};
+  static_assert(check_run(b2, ans2));
+
+  constexpr auto c3 = (value_node<>{1} | value_node<>{2}) + n1 + (value_node<>{3} | n2);
+  constexpr auto b3 = make_chain(value_node<>{1} | value_node<>{2}, n1, value_node<>{3} | n2);
+  static_assert(std::is_same_v<decltype(c3), decltype(b3)>);
+
+  auto graph = make_chain(value_node<>{1}, n1, value_node<>{2} | value_node<>{3});
+  using graph_type = decltype(graph);
+  static_assert(std::is_same_v<graph_type, std::decay_t<decltype(value_node<>{1} + n1 + (value_node<>{2} | value_node<>{3}))>>);
+  recorder<graph_type::node_num> rec{};
+  flat_executor<graph_type>{}.run(graph, rec);
+  static constexpr int ans3[graph_type::node_num] = {1, 1, 2, 3, 2, 3};
+  assert(rec.size == graph_type::node_num);
+  for (std::size_t i = 0; i < graph_type::node_num; ++i)
+    assert(rec.values[i] == ans3[i]);
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <type_traits>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void operator()(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct add_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr add_node<NextNodeType> copy() const { return add_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr add_node(int val): base_type(), value(val) {}
+  constexpr int process(int in) const { return in + value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct to_string_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  to_string_node<NextNodeType> copy() const { return {}; }
+  std::string process(int in) const { return std::to_string(in); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct length_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  length_node<NextNodeType> copy() const { return {}; }
+  int process(const std::string& in) const { return static_cast<int>(in.size()); }
+};
+
+// takes the ownership of the record, so it accepts only a moved record
+template <typename Next = hrlib::static_graph::terminal_node>
+struct owner_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  owner_node<NextNodeType> copy() const { return {}; }
+  std::unique_ptr<int> process(int in) const { return std::make_unique<int>(in); }
+};
+template <typename Next = hrlib::static_graph::terminal_node>
+struct release_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  release_node<NextNodeType> copy() const { return {}; }
+  std::vector<int>* out = nullptr;
+  void process(std::unique_ptr<int>&& in) const { out->push_back(*in); }
+};
+
+template <typename Graph, std::size_t N, std::size_t M>
+constexpr bool check_run(Graph graph, const int (&records)[M], const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::dataflow_executor<Graph>{}.run(graph, records, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = add_node<>{1} + add_node<>{10} + add_node<>{100};
+  static constexpr int records[] = {0, 1000};
+  static constexpr int ans1[] = {111, 1111};
+  static_assert(check_run(n1, records, ans1));
+
+  // or_node broadcasts, the node after it processes the output of every branch
+  constexpr auto n2 = add_node<>{1} + (add_node<>{10} | (add_node<>{20} + add_node<>{300})) + add_node<>{4000};
+  static constexpr int ans2[] = {4011, 4321, 5011, 5321};
+  static_assert(check_run(n2, records, ans2));
+  static constexpr int ans3[] = {11, 321, 1011, 1321};
+  static_assert(check_run(add_node<>{1} + (add_node<>{10} | (add_node<>{20} + add_node<>{300})), records, ans3));
+
+  using n1_type = std::remove_const_t<decltype(n1)>;
+  static_assert(is_dataflow_graph_v<n1_type, int>);
+  static_assert(!is_dataflow_graph_v<n1_type, std::string>);
+  using n3_type = decltype(add_node<>{1} + to_string_node<>{} + length_node<>{});
+  static_assert(is_dataflow_graph_v<n3_type, int>);
+  static_assert(!is_dataflow_graph_v<decltype(add_node<>{1} + to_string_node<>{} + add_node<>{1}), int>);
+  static_assert(!is_dataflow_graph_v<decltype(to_string_node<>{} + to_string_node<>{}), int>);
+  // a broadcast output is passed by const reference, so a node taking the ownership must not be a branch of an or_node
+  static_assert(is_dataflow_graph_v<decltype(owner_node<>{} + release_node<>{}), int>);
+  static_assert(!is_dataflow_graph_v<decltype(owner_node<>{} + (release_node<>{} | release_node<>{})), int>);
+  // a node returning void must be a last node
+  static_assert(!is_dataflow_graph_v<decltype(owner_node<>{} + release_node<>{} + add_node<>{1}), int>);
+
+  auto n3 = add_node<>{1} + to_string_node<>{} + length_node<>{};
+  std::vector<int> lengths;
+  dataflow_executor<n3_type>{}.run(n3, std::vector<int>{8, 9, 99, 12345}, [&lengths](int len){ lengths.push_back(len); });
+  assert((lengths == std::vector<int>{1, 2, 3, 5}));
+
+  auto n4 = add_node<>{1} + owner_node<>{} + release_node<>{};
+  std::vector<int> released;
+  std::get<2>(n4.get_nodes()).out = &released;
+  dataflow_executor<decltype(n4)> executor{};
+  executor.push(n4, 1);
+  executor.push(n4, 2);
+  assert((released == std::vector<int>{2, 3}));
+  return 0;
+}
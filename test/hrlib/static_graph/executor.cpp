@@ -0,0 +1,89 @@
+#include <type_traits>
+#include <tuple>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  static_assert(N == Graph::node_num);
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph, std::size_t N>
+constexpr bool check_successors(std::size_t node, const std::size_t (&ans)[N])
+{
+  using executor = hrlib::static_graph::flat_executor<Graph>;
+  if (executor::successor_offsets[node + 1] - executor::successor_offsets[node] != N)
+    return false;
+  for (std::size_t i = 0; i < N; ++i)
+    if (executor::successors[executor::successor_offsets[node] + i] != ans[i])
+      return false;
+  return true;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = value_node<>{1} + (value_node<>{2} + value_node<>{3});
+  constexpr auto n2 = (value_node<>{6} + value_node<>{5}) + value_node<>{4};
+  constexpr auto n3 = (value_node<>{7} + value_node<>{8}) + (value_node<>{9} | value_node<>{10});
+  constexpr auto n4 = n1 + (value_node<>{11} | n3 | value_node<>{12}) + n2;
+  using graph_type = std::remove_const_t<decltype(n4)>;
+
+  static_assert(std::is_same_v<node_at_t<graph_type, 3>, std::decay_t<decltype(node_at<3>(n4))>>);
+  static_assert(node_at<0>(n4).value == 1);
+  static_assert(node_at<3>(n4).value == 11);
+  static_assert(node_at<8>(n4).value == 12);
+  static_assert(node_at<11>(n4).value == 4);
+
+  static constexpr int ans[graph_type::node_num] = {1, 2, 3, 11, 7, 8, 9, 10, 12, 6, 5, 4};
+  static constexpr int ans1[graph_type::node_num] = {1, 2, 3, 11, 6, 5, 4, 7, 8, 9, 10, 12};
+  static_assert(check_run(n4, ans));
+  static_assert(!check_run(n4, ans1));
+
+  static_assert(flat_executor<graph_type>::successors.size() == 14);
+  static_assert(check_successors<graph_type>(2, {3, 4, 8}));
+  static_assert(check_successors<graph_type>(5, {6, 7}));
+  static_assert(check_successors<graph_type>(6, {9}));
+  static_assert(check_successors<graph_type>(7, {9}));
+  static_assert(flat_executor<graph_type>::successor_offsets[11] == flat_executor<graph_type>::successor_offsets[12]);
+
+  constexpr auto n5 = value_node<>{1} | value_node<>{2};
+  static constexpr int ans2[2] = {1, 2};
+  static_assert(check_run(n5, ans2));
+
+  auto graph = n4;
+  recorder<graph_type::node_num> rec{};
+  flat_executor<graph_type>{}.run(graph, rec);
+  assert(rec.size == graph_type::node_num);
+  for (std::size_t i = 0; i < graph_type::node_num; ++i)
+    assert(rec.values[i] == ans[i]);
+  return 0;
+}
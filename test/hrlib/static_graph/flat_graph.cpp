@@ -0,0 +1,116 @@
+#include <type_traits>
+#include <tuple>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/flat_graph.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct indexed_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr indexed_node<NextNodeType> copy() const { return indexed_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr indexed_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+// follows the next pointers from the node I, the successors of every node must be the nodes at the indices given by the topology
+template <std::size_t I, typename FlatGraph>
+bool check_pointers(FlatGraph& graph)
+{
+  using namespace hrlib::static_graph;
+  auto& node = node_at<I>(graph);
+  using successors = successors_t<FlatGraph, I>;
+  bool res = true;
+  if constexpr (successors::size() == 0)
+    res = node.next == &terminal;
+  else if constexpr (successors::size() == 1)
+    res = static_cast<const void*>(node.next) == static_cast<const void*>(&std::get<0>(successor_nodes<I>(graph)));
+  else
+    res = static_cast<const void*>(std::get<1>(node.next)) == static_cast<const void*>(&std::get<1>(successor_nodes<I>(graph)));
+  if constexpr (I + 1 < FlatGraph::node_num)
+    return res && check_pointers<I + 1>(graph);
+  else
+    return res;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  {
+    constexpr auto n1 = indexed_node<>{1} + (indexed_node<>{2} + indexed_node<>{3});
+    constexpr auto n2 = (indexed_node<>{6} + indexed_node<>{5}) + indexed_node<>{4};
+    constexpr auto n3 = (indexed_node<>{7} + indexed_node<>{8}) + (indexed_node<>{9} | indexed_node<>{10});
+    constexpr auto n4 = n1 + (indexed_node<>{11} | n3 | indexed_node<>{12}) + n2;
+    using graph_type = std::remove_const_t<decltype(n4)>;
+    using flat_type = flat_graph<graph_type>;
+    constexpr auto flat = flatten(n4);
+    static_assert(std::is_same_v<decltype(flat), const flat_type>);
+    static_assert(flat_type::node_num == graph_type::node_num);
+    static_assert(std::is_same_v<flat_nodes_t<flat_type>, flat_nodes_t<graph_type>>);
+    static_assert(std::is_same_v<successors_t<flat_type, 2>, successors_t<graph_type, 2>>);
+    static_assert(adjacency<flat_type>::edge_num == adjacency<graph_type>::edge_num);
+    static_assert(node_at<3>(flat).value == 11 && node_at<11>(flat).value == 4);
+    // no storage is added around the nodes
+    static_assert(sizeof(flat_type) == graph_type::node_num * sizeof(int));
+
+    static constexpr int ans[graph_type::node_num] = {1, 2, 3, 11, 7, 8, 9, 10, 12, 6, 5, 4};
+    static_assert(check_run(n4, ans));
+    static_assert(check_run(flat, ans));
+
+    // the nodes are laid out in execution order
+    auto graph = flatten(n4);
+    assert(reinterpret_cast<const char*>(&node_at<0>(graph)) == reinterpret_cast<const char*>(&graph));
+    assert(&node_at<1>(graph).value == &node_at<0>(graph).value + 1);
+    assert(&node_at<11>(graph).value == &node_at<0>(graph).value + 11);
+  }
+  {
+    constexpr auto n1 = value_node<>{1} + (value_node<>{2} | (value_node<>{3} + value_node<>{4})) + value_node<>{5};
+    using graph_type = std::remove_const_t<decltype(n1)>;
+    auto graph = flatten(n1);
+    graph.construct_connection();
+    assert(check_pointers<0>(graph));
+    static constexpr int ans[graph_type::node_num] = {1, 2, 3, 4, 5};
+    assert(check_run(graph, ans));
+    auto nested = n1;
+    auto moved = flatten(std::move(nested));
+    moved.construct_connection();
+    assert(check_pointers<0>(moved));
+  }
+  return 0;
+}
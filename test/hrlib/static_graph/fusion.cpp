@@ -0,0 +1,110 @@
+#include <type_traits>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/fusion.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+  constexpr void operator()(int value) { push(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+  constexpr int process(int in) const { return in * 10 + value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct to_string_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  to_string_node<NextNodeType> copy() const { return {}; }
+  std::string process(int in) const { return std::to_string(in); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct length_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  length_node<NextNodeType> copy() const { return {}; }
+  int process(const std::string& in) const { return static_cast<int>(in.size()); }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph, std::size_t N>
+constexpr bool check_process(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::dataflow_executor<Graph>{}.push(graph, 0, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = value_node<>{1} + value_node<>{2} + value_node<>{3} + (value_node<>{4} | (value_node<>{5} + value_node<>{6})) + value_node<>{7} + value_node<>{8};
+  constexpr auto f1 = fuse(n1);
+  using n1_type = std::remove_const_t<decltype(n1)>;
+  using f1_type = std::remove_const_t<decltype(f1)>;
+  static_assert(f1_type::node_num == 4);
+  static_assert(unfused_node_num_v<f1_type> == n1_type::node_num);
+  static_assert(unfused_node_num_v<n1_type> == n1_type::node_num);
+  static_assert(node_at_t<f1_type, 0>::fused_node_num == 3);
+  static_assert(node_at<1>(f1).value == 4);
+  static_assert(node_at_t<f1_type, 2>::fused_node_num == 2);
+  static_assert(node_at_t<f1_type, 3>::fused_node_num == 2);
+  static_assert(std::is_same_v<typename f1_type::head_type, node_at_t<f1_type, 0>>);
+
+  // the fused graph runs the nodes in the same order and gives the same outputs
+  static constexpr int ans1[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  static_assert(check_run(n1, ans1));
+  static_assert(check_run(f1, ans1));
+  static constexpr int ans2[] = {123478, 1235678};
+  static_assert(check_process(n1, ans2));
+  static_assert(check_process(f1, ans2));
+
+  // a chain of single nodes becomes one node, a single node is left as it is
+  constexpr auto f2 = fuse(value_node<>{1} + value_node<>{2} + value_node<>{3});
+  static_assert(std::remove_const_t<decltype(f2)>::fused_node_num == 3);
+  static_assert(f2.process(0) == 123);
+  static_assert(std::is_same_v<std::remove_const_t<decltype(fuse(value_node<>{1}))>, value_node<>>);
+  static_assert(is_combinable_node_v<std::remove_const_t<decltype(f2)>>);
+  static_assert(unfused_node_num_v<std::remove_const_t<decltype(fuse(f2 + value_node<>{4}))>> == 4);
+
+  auto n3 = value_node<>{1} + to_string_node<>{} + length_node<>{} + (value_node<>{2} | value_node<>{3});
+  auto f3 = fuse(std::move(n3));
+  static_assert(decltype(f3)::node_num == 3);
+  std::vector<int> out;
+  dataflow_executor<decltype(f3)>{}.run(f3, std::vector<int>{5, 12345}, [&out](int v){ out.push_back(v); });
+  assert((out == std::vector<int>{22, 23, 62, 63}));
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include <type_traits>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/graph_pool.hpp>
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct visit_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  visit_node<NextNodeType> copy() const { return visit_node<NextNodeType>{value}; }
+  int value = 0;
+  bool is_visited = false;
+  int runs = 0; // kept across runs, not reset
+  visit_node(int val): base_type(), value(val) {}
+  void reset() noexcept { is_visited = false; }
+  void run(int& sum)
+  {
+    assert(!is_visited);
+    is_visited = true;
+    ++runs;
+    sum += value;
+  }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct owner_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  owner_node<NextNodeType> copy() const { return {}; }
+  std::atomic<int> users{0};
+  owner_node() = default;
+  owner_node(const owner_node&): base_type(), users(0) {}
+  void run(int&)
+  {
+    assert(users.fetch_add(1) == 0);
+    users.fetch_sub(1);
+  }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  {
+    const auto prototype = visit_node<>{1} + (visit_node<>{2} | visit_node<>{3}) + visit_node<>{4};
+    using graph_type = std::remove_const_t<decltype(prototype)>;
+    graph_pool<graph_type> pool(prototype, 4);
+    assert(pool.size() == 4);
+
+    std::vector<graph_pool<graph_type>::handle> handles;
+    for (int i = 0; i < 4; ++i)
+    {
+      handles.push_back(pool.acquire());
+      assert(handles.back());
+      // the links are wired inside the instance
+      assert(std::get<0>(node_at<0>(*handles.back()).next) == &node_at<1>(*handles.back()));
+      assert(node_at<2>(*handles.back()).next == &node_at<3>(*handles.back()));
+    }
+    assert(!pool.acquire());
+
+    // a returned instance comes back with its per-run state reset
+    auto* first = handles[0].get();
+    int sum = 0;
+    flat_executor<graph_type>{}.run(*handles[0], sum);
+    assert(sum == 10 && node_at<3>(*first).is_visited);
+    handles[0].reset();
+    auto again = pool.acquire();
+    assert(again.get() == first);
+    assert(!node_at<3>(*again).is_visited && node_at<3>(*again).runs == 1);
+    flat_executor<graph_type>{}.run(*again, sum);
+    assert(sum == 20);
+  }
+  {
+    // every instance is used by one thread at a time
+    const auto prototype = owner_node<>{} + owner_node<>{};
+    using graph_type = std::remove_const_t<decltype(prototype)>;
+    graph_pool<graph_type> pool(prototype, 3);
+    std::atomic<int> runs{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t)
+      threads.emplace_back([&pool, &runs]{
+        for (int i = 0; i < 2000; ++i)
+        {
+          auto graph = pool.acquire();
+          if (!graph)
+            continue;
+          int dummy = 0;
+          flat_executor<graph_type>{}.run(*graph, dummy);
+          ++runs;
+        }
+      });
+    for (auto& thread: threads)
+      thread.join();
+    assert(runs > 0);
+    std::vector<graph_pool<graph_type>::handle> handles;
+    for (int i = 0; i < 3; ++i)
+      handles.push_back(pool.acquire());
+    assert(handles[0] && handles[1] && handles[2] && !pool.acquire());
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <type_traits>
+#include <string>
+#include <cstring>
+#include <new>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/incremental_executor.hpp>
+
+// a source node, its input is set from outside
+template <typename Next = hrlib::static_graph::terminal_node>
+struct input_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  input_node<NextNodeType> copy() const { return input_node<NextNodeType>{value}; }
+  int value = 0;
+  int evaluations = 0;
+  input_node(int val): base_type(), value(val) {}
+  int evaluate() { ++evaluations; return value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct sum_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  sum_node<NextNodeType> copy() const { return sum_node<NextNodeType>{offset}; }
+  int offset = 0;
+  int evaluations = 0;
+  sum_node(int offset): base_type(), offset(offset) {}
+  template <typename... Ins>
+  int evaluate(const Ins&... ins) { ++evaluations; return (offset + ... + ins); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct format_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  format_node<NextNodeType> copy() const { return {}; }
+  std::string evaluate(const int& in) const { return "<" + std::to_string(in) + ">"; }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  // 0 -> 1 -> 2, {2, 3} -> 4 -> 5
+  auto graph = ((input_node<>{1} + sum_node<>{10} + sum_node<>{100}) | input_node<>{1000}) + sum_node<>{0} + format_node<>{};
+  using graph_type = decltype(graph);
+  static_assert(std::is_same_v<predecessors_t<graph_type, 4>, std::index_sequence<2, 3>>);
+  static_assert(std::is_same_v<incremental_executor<graph_type>::output_type<5>, std::string>);
+
+  incremental_executor<graph_type> executor;
+  assert(executor.run(graph) == 6);
+  assert(executor.output<4>() == 1 + 10 + 100 + 1000);
+  assert(executor.output<5>() == "<1111>");
+  assert(executor.run(graph) == 0);
+
+  // the second input only reaches the join and the nodes after it
+  node_at<3>(graph).value = 2000;
+  executor.invalidate(3);
+  assert(!executor.is_dirty(0) && !executor.is_dirty(1) && !executor.is_dirty(2));
+  assert(executor.is_dirty(3) && executor.is_dirty(4) && executor.is_dirty(5));
+  assert(executor.run(graph) == 3);
+  assert(executor.output<5>() == "<2111>");
+  assert(node_at<0>(graph).evaluations == 1 && node_at<1>(graph).evaluations == 1 && node_at<2>(graph).evaluations == 1);
+  assert(node_at<4>(graph).evaluations == 2);
+
+  node_at<0>(graph).value = 2;
+  executor.invalidate(0);
+  assert(executor.run(graph) == 5);
+  assert(executor.output<2>() == 112 && executor.output<5>() == "<2112>");
+  assert(node_at<3>(graph).evaluations == 2);
+
+  // invalidate(1) marks the nodes reachable from 1
+  static_assert(reachable_v<graph_type, 1, 1> && reachable_v<graph_type, 1, 2> && reachable_v<graph_type, 1, 4> && reachable_v<graph_type, 1, 5>);
+  static_assert(!reachable_v<graph_type, 1, 0> && !reachable_v<graph_type, 1, 3>);
+  static_assert(reachable_v<graph_type, 5, 5> && !reachable_v<graph_type, 5, 4>);
+  executor.invalidate(1);
+  assert(!executor.is_dirty(0) && executor.is_dirty(1) && executor.is_dirty(2) && !executor.is_dirty(3) && executor.is_dirty(4) && executor.is_dirty(5));
+  assert(executor.run(graph) == 4);
+
+  // an executor created in storage which held other data starts with exactly the nodes of the graph dirty
+  {
+    using executor_type = incremental_executor<graph_type>;
+    alignas(executor_type) unsigned char storage[sizeof(executor_type)];
+    std::memset(storage, 0xff, sizeof(storage));
+    auto fresh = ::new (static_cast<void*>(storage)) executor_type;
+    assert(fresh->run(graph) == 6);
+    assert(fresh->output<5>() == "<2112>");
+    fresh->invalidate(3);
+    assert(fresh->run(graph) == 3);
+    fresh->~executor_type();
+  }
+  return 0;
+}
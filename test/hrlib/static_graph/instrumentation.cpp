@@ -0,0 +1,83 @@
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/parallel_executor.hpp>
+#include <hrlib/static_graph/instrumentation.hpp>
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct sleep_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr sleep_node<NextNodeType> copy() const { return sleep_node<NextNodeType>{milliseconds}; }
+  int milliseconds = 0;
+  constexpr sleep_node(int ms): base_type(), milliseconds(ms) {}
+  void run() { std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds)); }
+};
+
+struct trace_instrumentation
+{
+  std::vector<int>* trace;
+  void on_enter(std::size_t index) const { trace->push_back(static_cast<int>(index)); }
+  void on_exit(std::size_t index) const { trace->push_back(-static_cast<int>(index) - 1); }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  static_assert(std::is_empty_v<no_instrumentation>);
+
+  auto graph = sleep_node<>{0} + (sleep_node<>{0} | sleep_node<>{5}) + sleep_node<>{0};
+  using graph_type = decltype(graph);
+
+  std::vector<int> trace;
+  flat_executor<graph_type, trace_instrumentation>{trace_instrumentation{&trace}}.run(graph);
+  assert((trace == std::vector<int>{0, -1, 1, -2, 2, -3, 3, -4}));
+
+  // the time of a node is measured inside the time of the whole run
+  node_profiler profiler(graph_type::node_num);
+  flat_executor<graph_type, profiling_instrumentation> executor{profiling_instrumentation(profiler)};
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 3; ++i)
+    executor.run(graph);
+  const auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  auto profile = profiler.snapshot();
+  assert(profile.size() == 4);
+  std::uint64_t sum = 0;
+  for (const auto& p: profile)
+  {
+    assert(p.calls == 3);
+    sum += p.nanoseconds;
+  }
+  assert(profile[2].nanoseconds > 0 && sum <= static_cast<std::uint64_t>(total));
+
+  // the counters of every thread are summed up
+  work_stealing_pool pool(2);
+  parallel_executor<graph_type, profiling_instrumentation> parallel(pool, profiling_instrumentation(profiler));
+  for (int i = 0; i < 5; ++i)
+    parallel.run(graph);
+  const auto sequential_nanoseconds = profile[2].nanoseconds;
+  profile = profiler.snapshot();
+  for (const auto& p: profile)
+    assert(p.calls == 8);
+  assert(profile[2].nanoseconds > sequential_nanoseconds);
+
+  // a thread alternating between profilers records into the block of each one
+  node_profiler other(graph_type::node_num);
+  flat_executor<graph_type, profiling_instrumentation> other_executor{profiling_instrumentation(other)};
+  for (int i = 0; i < 4; ++i)
+  {
+    executor.run(graph);
+    other_executor.run(graph);
+  }
+  for (const auto& p: profiler.snapshot())
+    assert(p.calls == 12);
+  for (const auto& p: other.snapshot())
+    assert(p.calls == 4);
+  return 0;
+}
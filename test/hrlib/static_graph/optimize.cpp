@@ -0,0 +1,129 @@
+#include <type_traits>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/optimize.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+  constexpr void operator()(int value) { push(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+  constexpr int process(int in) const { return in * 10 + value; }
+};
+
+// disabled by the configuration, never runs
+template <typename Next = hrlib::static_graph::terminal_node>
+struct disabled_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  static constexpr bool enabled = false;
+  template <typename NextNodeType>
+  constexpr disabled_node<NextNodeType> copy() const { return {}; }
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(-1); }
+  constexpr int process(int) const { return -1; }
+};
+
+template <int Value, typename Next = hrlib::static_graph::terminal_node>
+struct pure_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  static constexpr bool pure = true;
+  template <typename NextNodeType>
+  constexpr pure_node<Value, NextNodeType> copy() const { return {}; }
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(Value); }
+  constexpr int process(int in) const { return in * 10 + Value; }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph, std::size_t N>
+constexpr bool check_process(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::dataflow_executor<Graph>{}.push(graph, 0, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph>
+using graph_t = std::remove_const_t<Graph>;
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  static_assert(!node_enabled_v<disabled_node<>> && node_enabled_v<value_node<>>);
+  static_assert(node_pure_v<pure_node<1>> && !node_pure_v<value_node<>>);
+
+  // a disabled branch is dropped
+  constexpr auto n1 = value_node<>{1} + (value_node<>{2} | disabled_node<>{} | value_node<>{3}) + value_node<>{4};
+  constexpr auto o1 = optimize(n1);
+  using o1_type = graph_t<decltype(o1)>;
+  static_assert(o1_type::node_num == 4);
+  static constexpr int ans1[] = {1, 2, 3, 4};
+  static_assert(check_run(o1, ans1));
+  static constexpr int ans2[] = {124, 134};
+  static_assert(check_process(o1, ans2));
+
+  // an or_node left with one branch becomes a plain chain, a chain with a disabled node is dropped as a whole
+  constexpr auto n2 = value_node<>{1} + ((value_node<>{2} + value_node<>{3}) | (value_node<>{5} + disabled_node<>{})) + value_node<>{4};
+  constexpr auto o2 = optimize(n2);
+  using o2_type = graph_t<decltype(o2)>;
+  static_assert(std::is_same_v<typename o2_type::node_type_tag, chained_node_tag>);
+  static_assert(o2_type::chain_size == 4 && o2_type::node_num == 4);
+  static_assert(check_run(o2, ans1));
+
+  // of identical pure branches only the first is kept, branches of nodes which are not pure are kept
+  constexpr auto n3 = value_node<>{1} + ((pure_node<2>{} + pure_node<3>{}) | (pure_node<2>{} + pure_node<3>{}) | pure_node<5>{} | value_node<>{6} | value_node<>{6});
+  constexpr auto o3 = optimize(n3);
+  using o3_type = graph_t<decltype(o3)>;
+  static_assert(o3_type::node_num == 6);
+  static constexpr int ans3[] = {1, 2, 3, 5, 6, 6};
+  static_assert(check_run(o3, ans3));
+  static_assert(std::is_same_v<graph_t<decltype(optimize(pure_node<2>{} | pure_node<2>{}))>, pure_node<2>>);
+
+  // removing branches of an inner or_node may leave identical outer branches
+  constexpr auto n4 = value_node<>{1} + ((pure_node<2>{} + (pure_node<3>{} | disabled_node<>{})) | (pure_node<2>{} + pure_node<3>{}));
+  using o4_type = graph_t<decltype(optimize(n4))>;
+  static_assert(o4_type::node_num == 3);
+
+  // a graph without disabled or duplicated nodes keeps its type
+  static_assert(std::is_same_v<graph_t<decltype(optimize(n1 + value_node<>{5}))>, graph_t<decltype(o1 + value_node<>{5})>>);
+  constexpr auto n5 = value_node<>{1} + (value_node<>{2} | value_node<>{3});
+  static_assert(std::is_same_v<graph_t<decltype(optimize(n5))>, graph_t<decltype(n5)>>);
+
+  // the pointer links of the result are connected as for any copied graph
+  auto o6 = optimize(n1);
+  o6.construct_connection();
+  assert(std::get<1>(node_at<0>(o6).next) == &node_at<2>(o6));
+  assert(node_at<2>(o6).next == &node_at<3>(o6));
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include <type_traits>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/parallel_executor.hpp>
+
+template <std::size_t N>
+struct context
+{
+  std::atomic<int> ticket{0};
+  int stamps[N] = {};
+  std::atomic<int> active{0};
+  std::atomic<int> max_active{0};
+  bool sleep = false;
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct stamp_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr stamp_node<NextNodeType> copy() const { return stamp_node<NextNodeType>{id}; }
+  std::size_t id = 0;
+  constexpr stamp_node(std::size_t id): base_type(), id(id) {}
+  template <typename Context>
+  void run(Context& ctx)
+  {
+    const auto active = ++ctx.active;
+    auto max_active = ctx.max_active.load();
+    while (active > max_active && !ctx.max_active.compare_exchange_weak(max_active, active));
+    if (ctx.sleep)
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ctx.stamps[id] = ++ctx.ticket;
+    --ctx.active;
+  }
+};
+
+template <typename Graph, std::size_t N>
+bool check_order(const context<N>& ctx)
+{
+  using table = hrlib::static_graph::detail::successor_table<Graph>;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    if (ctx.stamps[i] == 0)
+      return false;
+    for (auto j = table::successor_offsets[i]; j < table::successor_offsets[i + 1]; ++j)
+      if (ctx.stamps[i] >= ctx.stamps[table::successors[j]])
+        return false;
+  }
+  return true;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = stamp_node<>{0} + (stamp_node<>{1} + stamp_node<>{2});
+  constexpr auto n2 = (stamp_node<>{9} + stamp_node<>{10}) + stamp_node<>{11};
+  constexpr auto n3 = (stamp_node<>{4} + stamp_node<>{5}) + (stamp_node<>{6} | stamp_node<>{7});
+  constexpr auto n4 = n1 + (stamp_node<>{3} | n3 | stamp_node<>{8}) + n2;
+  using graph_type = std::remove_const_t<decltype(n4)>;
+  static_assert(detail::successor_table<graph_type>::predecessor_counts[9] == 4);
+
+  work_stealing_pool pool(4);
+  parallel_executor<graph_type> executor(pool);
+  auto graph = n4;
+  for (int i = 0; i < 1000; ++i)
+  {
+    context<graph_type::node_num> ctx;
+    executor.run(graph, ctx);
+    assert(check_order<graph_type>(ctx));
+  }
+
+  // the branches of the or_node run at the same time
+  context<graph_type::node_num> ctx;
+  ctx.sleep = true;
+  executor.run(graph, ctx);
+  assert(check_order<graph_type>(ctx));
+  assert(ctx.max_active >= 2);
+
+  constexpr auto n5 = stamp_node<>{0} | stamp_node<>{1} | stamp_node<>{2};
+  auto graph1 = n5;
+  context<3> ctx1;
+  parallel_executor<std::remove_const_t<decltype(n5)>>(pool).run(graph1, ctx1);
+  assert(check_order<std::remove_const_t<decltype(n5)>>(ctx1));
+
+  // a task pushed from outside wakes a sleeping worker, the calling thread does not help here
+  std::atomic<int> done{0};
+  for (int i = 0; i < 200; ++i)
+  {
+    pool.push({[](void* counter, std::size_t){ static_cast<std::atomic<int>*>(counter)->fetch_add(1); }, &done, 0});
+    if (i % 20 == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  while (done.load() != 200)
+    std::this_thread::yield();
+  assert(!pool.run_one());
+  return 0;
+}
@@ -0,0 +1,139 @@
+#include <type_traits>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/spsc_ring.hpp>
+#include <hrlib/static_graph/pipeline_executor.hpp>
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct add_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  add_node<NextNodeType> copy() const { return add_node<NextNodeType>{value, sleep}; }
+  int value = 0;
+  bool sleep = false;
+  add_node(int val, bool sleep = false): base_type(), value(val), sleep(sleep) {}
+  int process(int in) const
+  {
+    if (sleep)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return in + value;
+  }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct to_string_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  to_string_node<NextNodeType> copy() const { return {}; }
+  std::string process(int in) const { return std::to_string(in); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct length_node: hrlib::static_graph::single_node_base<Next>
+{
+  template <typename NextNodeType>
+  length_node<NextNodeType> copy() const { return {}; }
+  std::size_t process(const std::string& in) const { return in.size(); }
+};
+
+// yields 0, 1, ... and throws when it reaches throw_at
+struct throwing_range
+{
+  int throw_at;
+  struct iterator
+  {
+    int value;
+    int throw_at;
+    int operator*() const { return value; }
+    iterator& operator++()
+    {
+      if (++value == throw_at)
+        throw std::runtime_error("input");
+      return *this;
+    }
+    bool operator!=(const iterator& other) const { return value != other.value; }
+  };
+  iterator begin() const { return {0, throw_at}; }
+  iterator end() const { return {throw_at + 1, throw_at}; }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  {
+    spsc_ring<std::string> ring(3);
+    assert(ring.capacity() == 4);
+    for (int i = 0; i < 4; ++i)
+      assert(ring.try_push(std::to_string(i)));
+    assert(!ring.try_push(std::string("4")));
+    std::string s;
+    assert(ring.try_pop(s) && s == "0" && ring.known_size() == 3);
+    // the consumer learns of the new element only when it reads the tail again
+    assert(ring.try_push(std::string("4")) && ring.size() == 4 && ring.known_size() == 3);
+    ring.close();
+    for (int i = 1; i < 4; ++i)
+      assert(!ring.is_drained() && ring.try_pop(s) && s == std::to_string(i));
+    assert(ring.known_size() == 0 && ring.try_pop(s) && s == "4" && ring.known_size() == 0);
+    assert(!ring.try_pop(s) && ring.is_drained());
+  }
+
+  std::vector<int> records(1000);
+  std::iota(records.begin(), records.end(), 0);
+
+  // the stages are add_node{1}, the or_node and add_node{100}, records keep their order
+  auto n1 = add_node<>{1} + (add_node<>{10} | add_node<>{20}) + add_node<>{100};
+  using n1_type = decltype(n1);
+  static_assert(pipeline_executor<n1_type, int>::stage_num == 3 && pipeline_executor<n1_type, int>::group_num == 3);
+  pipeline_executor<n1_type, int> e1(16);
+  std::vector<int> out1;
+  e1.run(n1, records, [&out1](int out){ out1.push_back(out); });
+  assert(out1.size() == 2000);
+  for (int i = 0; i < 1000; ++i)
+    assert(out1[2 * i] == i + 111 && out1[2 * i + 1] == i + 121);
+  assert(e1.stats()[0].processed == 1000 && e1.stats()[1].processed == 1000 && e1.stats()[2].processed == 2000);
+
+  // the records change their type between the groups
+  auto n2 = add_node<>{1} + to_string_node<>{} + length_node<>{};
+  using n2_type = decltype(n2);
+  using e2_type = pipeline_executor<n2_type, int, std::index_sequence<2, 1>>;
+  static_assert(std::is_same_v<e2_type::stage_input_type<2>, std::string>);
+  e2_type e2(4);
+  std::vector<std::size_t> out2;
+  e2.run(n2, std::vector<int>{8, 9, 99, 12345}, [&out2](std::size_t len){ out2.push_back(len); });
+  assert((out2 == std::vector<std::size_t>{1, 2, 3, 5}));
+  assert(e2.stats().size() == 2 && e2.stats()[1].processed == 4);
+
+  // the slow stage has a deep input ring, the stage after it is starved
+  auto n4 = add_node<>{1} + add_node<>{2, true} + add_node<>{3};
+  pipeline_executor<decltype(n4), int> e4(64);
+  e4.run(n4, std::vector<int>(50, 0));
+  assert(e4.stats()[1].max_depth > e4.stats()[2].max_depth);
+  assert(e4.stats()[1].average_depth() > e4.stats()[2].average_depth());
+  assert(e4.stats()[2].empty_waits > 0);
+  // a group waiting for room in the input ring of the slow group counts the waits in its own stats
+  pipeline_executor<decltype(n4), int> e5(2);
+  e5.run(n4, std::vector<int>(20, 0));
+  assert(e5.stats()[0].full_waits > 0 && e5.stats()[1].full_waits == 0);
+
+  // the records before an exception of the input range are processed, then the exception reaches the caller
+  std::vector<int> out6;
+  bool thrown = false;
+  try
+  {
+    e1.run(n1, throwing_range{5}, [&out6](int out){ out6.push_back(out); });
+  }
+  catch (const std::runtime_error&)
+  {
+    thrown = true;
+  }
+  assert(thrown && out6.size() == 10);
+  return 0;
+}
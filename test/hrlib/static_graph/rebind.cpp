@@ -0,0 +1,74 @@
+#include <type_traits>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+
+struct payload
+{
+  static inline int copy_count = 0;
+  std::vector<int> data;
+  payload(std::size_t size, int value): data(size, value) {}
+  payload(const payload& other): data(other.data) { ++copy_count; }
+  payload(payload&&) = default;
+  payload& operator=(const payload&) = delete;
+  payload& operator=(payload&&) = default;
+};
+
+// provides only rebind, lvalues are copied once and then rebound
+template <typename Next = hrlib::static_graph::terminal_node>
+struct heavy_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  heavy_node<NextNodeType> rebind() && { return heavy_node<NextNodeType>{std::move(buffer)}; }
+  payload buffer;
+  heavy_node(payload&& buffer): base_type(), buffer(std::move(buffer)) {}
+  heavy_node(std::size_t size, int value): base_type(), buffer(size, value) {}
+};
+
+// provides both, copy is used for lvalues and rebind for rvalues
+template <typename Next = hrlib::static_graph::terminal_node>
+struct dual_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  dual_node<NextNodeType> copy() const { return dual_node<NextNodeType>{payload(buffer)}; }
+  template <typename NextNodeType>
+  dual_node<NextNodeType> rebind() && { return dual_node<NextNodeType>{std::move(buffer)}; }
+  payload buffer;
+  dual_node(payload&& buffer): base_type(), buffer(std::move(buffer)) {}
+  dual_node(std::size_t size, int value): base_type(), buffer(size, value) {}
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  static_assert(single_node_constraints_v<heavy_node<>>);
+  static_assert(is_combinable_single_node_v<heavy_node<>>);
+  static_assert(is_combinable_node_v<dual_node<>>);
+
+  auto g1 = heavy_node<>{64, 1} + (heavy_node<>{64, 2} | dual_node<>{64, 3}) + (dual_node<>{64, 4} + heavy_node<>{64, 5});
+  assert(payload::copy_count == 0);
+  auto g2 = (dual_node<>{64, 6} + heavy_node<>{64, 7}) + std::move(g1);
+  assert(payload::copy_count == 0);
+  auto g3 = make_chain(heavy_node<>{64, 8}, std::move(g2), make_parallel(heavy_node<>{64, 9}, dual_node<>{64, 10}));
+  assert(payload::copy_count == 0);
+  static_assert(decltype(g3)::node_num == 10);
+  assert(node_at<0>(g3).buffer.data[0] == 8);
+  assert(node_at<2>(g3).buffer.data[0] == 7);
+  assert(node_at<5>(g3).buffer.data[0] == 3);
+  assert(node_at<9>(g3).buffer.data.size() == 64 && node_at<9>(g3).buffer.data[0] == 10);
+  g3.construct_connection();
+  assert(node_at<0>(g3).next == &node_at<1>(g3));
+
+  // composing lvalues still works and copies each payload once
+  auto n1 = heavy_node<>{64, 11};
+  auto n2 = dual_node<>{64, 12};
+  auto g4 = n1 + n2;
+  assert(payload::copy_count == 2);
+  assert(n1.buffer.data.size() == 64 && n2.buffer.data.size() == 64);
+  assert(std::get<0>(g4.get_nodes()).buffer.data[0] == 11);
+  return 0;
+}
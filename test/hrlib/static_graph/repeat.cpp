@@ -0,0 +1,115 @@
+#include <type_traits>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/dataflow.hpp>
+#include <hrlib/static_graph/repeat.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  constexpr void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct add_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr add_node<NextNodeType> copy() const { return add_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr add_node(int val): base_type(), value(val) {}
+  constexpr int process(int in) const { return in + value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct mul_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr mul_node<NextNodeType> copy() const { return mul_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr mul_node(int val): base_type(), value(val) {}
+  constexpr int process(int in) const { return in * value; }
+};
+
+template <typename Graph, std::size_t N>
+constexpr bool check_run(Graph graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::flat_executor<Graph>{}.run(graph, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph>
+constexpr int push_one(Graph graph, int value)
+{
+  int res = 0;
+  hrlib::static_graph::dataflow_executor<Graph>{}.push(graph, value, [&res](int out){ res = out; });
+  return res;
+}
+
+struct less_than
+{
+  int limit;
+  constexpr bool operator()(int value) const { return value < limit; }
+  template <std::size_t N>
+  constexpr bool operator()(const recorder<N>& rec) const { return rec.size < static_cast<std::size_t>(limit); }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  {
+    constexpr auto g = value_node<>{1} + repeat<3>(value_node<>{2} + (value_node<>{3} | value_node<>{4})) + value_node<>{5};
+    using graph_type = std::remove_const_t<decltype(g)>;
+    using repeat_type = node_at_t<graph_type, 1>;
+    // the repeat node is one single node, the subgraph keeps its own introspection
+    static_assert(graph_type::node_num == 3);
+    static_assert(repeat_type::node_num == 1 && repeat_type::repeat_count == 3);
+    static_assert(repeat_type::subgraph_type::node_num == 3);
+    static_assert(std::is_same_v<node_heads_t<graph_type>, type_list<node_at_t<graph_type, 0>>>);
+    static_assert(std::is_same_v<node_lasts_t<typename repeat_type::subgraph_type>, type_list<value_node<>, value_node<>>>);
+    static constexpr int ans[] = {1, 2, 3, 4, 2, 3, 4, 2, 3, 4, 5};
+    static_assert(check_run(g, ans));
+
+    // the links of the subgraph are wired by construct_connection() of the enclosing graph
+    auto graph = g;
+    graph.construct_connection();
+    auto& subgraph = node_at<1>(graph).get_subgraph();
+    assert(node_at<0>(graph).next == &node_at<1>(graph));
+    assert(std::get<1>(node_at<0>(subgraph).next) == &node_at<2>(subgraph));
+  }
+  {
+    constexpr auto g = add_node<>{1} + repeat<4>(add_node<>{1} + mul_node<>{2}) + add_node<>{0};
+    using graph_type = std::remove_const_t<decltype(g)>;
+    static_assert(is_dataflow_graph_v<graph_type, int>);
+    // 1 -> 4 -> 10 -> 22 -> 46
+    static_assert(push_one(g, 0) == 46);
+
+    constexpr auto w = repeat_while(less_than{100}, mul_node<>{3});
+    static_assert(push_one(w, 1) == 243);
+    static_assert(push_one(w, 100) == 100);
+    constexpr auto r = repeat_while(less_than{7}, value_node<>{8} + value_node<>{9});
+    static constexpr int ans[] = {8, 9, 8, 9, 8, 9, 8, 9};
+    static_assert(check_run(r, ans));
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include <type_traits>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <hrlib/error_handling/result.hpp>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/result_executor.hpp>
+
+using hrlib::error_handling::Result;
+using int_result = Result<int, std::string>;
+
+// fails for a negative input
+template <typename Next = hrlib::static_graph::terminal_node>
+struct check_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  check_node<NextNodeType> copy() const { return check_node<NextNodeType>{name}; }
+  std::string name;
+  int calls = 0;
+  check_node(std::string name): base_type(), name(std::move(name)) {}
+  int_result process(int in)
+  {
+    ++calls;
+    if (in < 0)
+      return int_result::Err(name);
+    return int_result::Ok(in);
+  }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct add_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  add_node<NextNodeType> copy() const { return add_node<NextNodeType>{value}; }
+  int value = 0;
+  int calls = 0;
+  add_node(int val): base_type(), value(val) {}
+  int_result process(int in) { ++calls; return int_result::Ok(in + value); }
+};
+
+// the join of two branches with the default merge policy
+template <typename Next = hrlib::static_graph::terminal_node>
+struct sum_node: hrlib::static_graph::single_node_base<Next>
+{
+  using merged_error_type = hrlib::error_handling::result::MergeResult<std::string, std::string>;
+  using result_type = Result<int, merged_error_type>;
+  template <typename NextNodeType>
+  sum_node<NextNodeType> copy() const { return {}; }
+  int calls = 0;
+  result_type process(hrlib::error_handling::result::MergeResult<int, int>&& in)
+  {
+    ++calls;
+    return result_type::Ok(std::get<0>(in.tuple) + std::get<1>(in.tuple));
+  }
+};
+
+// adds the ok values and keeps the first error
+struct sum_policy
+{
+  static int_result merge(const int_result& lhs, const int_result& rhs)
+  {
+    if (!lhs)
+      return int_result::Err(lhs.get_err());
+    if (!rhs)
+      return int_result::Err(rhs.get_err());
+    return int_result::Ok(lhs.get_ok() + rhs.get_ok());
+  }
+};
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  {
+    // 0 -> 1 -> 2
+    auto graph = check_node<>{"first"} + add_node<>{10} + check_node<>{"second"};
+    using graph_type = decltype(graph);
+    static_assert(std::is_same_v<node_result_t<graph_type, int, 2>, int_result>);
+    result_executor<graph_type> executor;
+    std::vector<int_result> results;
+    auto sink = [&results](int_result&& result){ results.push_back(std::move(result)); };
+    executor.push(graph, 1, sink);
+    executor.push(graph, -1, sink);
+    executor.push(graph, -5, sink);
+    assert(results.size() == 3);
+    assert(results[0] && results[0].get_ok() == 11);
+    assert(!results[1] && results[1].get_err() == "first");
+    assert(!results[2] && results[2].get_err() == "first");
+    // the nodes after the failing one are skipped
+    assert(node_at<0>(graph).calls == 3);
+    assert(node_at<1>(graph).calls == 1);
+    assert(node_at<2>(graph).calls == 1);
+
+    results.clear();
+    executor.run(graph, std::vector<int>{-20, 3, -9}, sink);
+    assert(results.size() == 3);
+    assert(!results[0] && results[1] && results[1].get_ok() == 13 && !results[2]);
+  }
+  {
+    // 0 -> {1, 2}, {1, 2} -> 3
+    auto graph = add_node<>{0} + (check_node<>{"left"} | (add_node<>{-10} + check_node<>{"right"})) + sum_node<>{};
+    using graph_type = decltype(graph);
+    using merged_error_type = sum_node<>::merged_error_type;
+    static_assert(std::is_same_v<node_result_t<graph_type, int, 4>, Result<int, merged_error_type>>);
+    result_executor<graph_type> executor;
+    std::vector<Result<int, merged_error_type>> results;
+    auto sink = [&results](auto&& result){ results.push_back(std::move(result)); };
+    executor.push(graph, 20, sink);
+    assert(results.size() == 1 && results[0] && results[0].get_ok() == 20 + 10);
+    assert(node_at<4>(graph).calls == 1);
+    // only the right branch fails, the join is skipped
+    executor.push(graph, 5, sink);
+    assert(results.size() == 2 && !results[1]);
+    assert(std::get<0>(results[1].get_err().tuple) == "" && std::get<1>(results[1].get_err().tuple) == "right");
+    // both branches fail
+    executor.push(graph, -1, sink);
+    assert(std::get<0>(results[2].get_err().tuple) == "left" && std::get<1>(results[2].get_err().tuple) == "right");
+    assert(node_at<4>(graph).calls == 1);
+  }
+  {
+    // a custom merge policy, three branches
+    auto graph = (check_node<>{"a"} | (add_node<>{-10} + check_node<>{"b"}) | add_node<>{1}) + check_node<>{"sum"};
+    using graph_type = decltype(graph);
+    result_executor<graph_type, sum_policy> executor;
+    std::vector<int_result> results;
+    auto sink = [&results](int_result&& result){ results.push_back(std::move(result)); };
+    executor.push(graph, 12, sink);
+    executor.push(graph, 3, sink);
+    assert(results.size() == 2);
+    assert(results[0] && results[0].get_ok() == 12 + 2 + 13);
+    assert(!results[1] && results[1].get_err() == "b");
+    assert(node_at<4>(graph).calls == 1);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <type_traits>
+#include <vector>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+#include <hrlib/static_graph/executor.hpp>
+#include <hrlib/static_graph/runtime_graph.hpp>
+
+struct recorder
+{
+  std::vector<int> values;
+  void push(int value) { values.push_back(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+  template <typename Recorder>
+  void run(Recorder& rec) { rec.push(value); }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct counted_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  counted_node<NextNodeType> copy() const { return counted_node<NextNodeType>{destroyed}; }
+  int* destroyed;
+  counted_node(int* destroyed): base_type(), destroyed(destroyed) {}
+  counted_node(const counted_node&) = default;
+  ~counted_node() { ++*destroyed; }
+  void run(recorder& rec) { rec.push(-1); }
+};
+
+bool same_edges(const std::vector<hrlib::static_graph::edge>& lhs, const std::vector<hrlib::static_graph::edge>& rhs)
+{
+  if (lhs.size() != rhs.size())
+    return false;
+  for (auto l: lhs)
+  {
+    bool found = false;
+    for (auto r: rhs)
+      found = found || (l.from == r.from && l.to == r.to);
+    if (!found)
+      return false;
+  }
+  return true;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = value_node<>{1} + (value_node<>{2} + value_node<>{3});
+  constexpr auto n2 = (value_node<>{6} + value_node<>{5}) + value_node<>{4};
+  constexpr auto n3 = (value_node<>{7} + value_node<>{8}) + (value_node<>{9} | value_node<>{10});
+  constexpr auto n4 = n1 + (value_node<>{11} | n3 | value_node<>{12}) + n2;
+  using graph_type = std::remove_const_t<decltype(n4)>;
+  using adj = adjacency<graph_type>;
+
+  runtime_arena<recorder> arena;
+  // the same graph, composed at runtime from single nodes
+  auto r1 = arena.make(value_node<>{1}) + (arena.make(value_node<>{2}) + arena.make(value_node<>{3}));
+  auto r2 = (arena.make(value_node<>{6}) + arena.make(value_node<>{5})) + arena.make(value_node<>{4});
+  auto r3 = (arena.make(value_node<>{7}) + arena.make(value_node<>{8})) + (arena.make(value_node<>{9}) | arena.make(value_node<>{10}));
+  auto r4 = std::move(r1) + (arena.make(value_node<>{11}) | std::move(r3) | arena.make(value_node<>{12})) + std::move(r2);
+  // and converted from the static graph
+  auto converted = arena.make(n4);
+
+  std::vector<edge> static_edges;
+  for (std::size_t i = 0; i < adj::node_num; ++i)
+    for (auto successor: adj::successors_of(i))
+      static_edges.push_back(edge{i, successor});
+  for (const auto* graph: {&r4, &converted})
+  {
+    assert(graph->node_num() == graph_type::node_num);
+    assert(same_edges(graph->get_edges(), static_edges));
+    assert(graph->get_heads() == std::vector<std::size_t>{0});
+    assert(graph->get_lasts() == std::vector<std::size_t>{11});
+  }
+
+  recorder static_rec, runtime_rec, converted_rec;
+  auto graph = n4;
+  flat_executor<graph_type>{}.run(graph, static_rec);
+  r4.run(runtime_rec);
+  converted.run(converted_rec);
+  assert(runtime_rec.values == static_rec.values);
+  assert(converted_rec.values == static_rec.values);
+
+  // the nodes share the blocks of the arena
+  assert(arena.node_num() == 2 * graph_type::node_num);
+  assert(arena.block_num() == 1);
+
+  // a chain whose length is known only at runtime
+  auto chain = arena.make(value_node<>{0});
+  for (int i = 1; i < 100; ++i)
+    chain = std::move(chain) + arena.make(value_node<>{i});
+  assert(chain.node_num() == 100 && chain.get_edges().size() == 99);
+  recorder chain_rec;
+  chain.run(chain_rec);
+  for (int i = 0; i < 100; ++i)
+    assert(chain_rec.values[i] == i);
+
+  // the arena destroys its nodes
+  int destroyed = 0;
+  {
+    runtime_arena<recorder> small_arena(16);
+    auto g = small_arena.make(counted_node<>{&destroyed}) | small_arena.make(counted_node<>{&destroyed});
+    assert(small_arena.block_num() == 2);
+    destroyed = 0;
+  }
+  assert(destroyed == 2);
+  return 0;
+}
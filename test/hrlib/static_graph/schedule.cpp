@@ -0,0 +1,227 @@
+#include <type_traits>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/schedule.hpp>
+#include <hrlib/static_graph/scheduled_executor.hpp>
+
+template <std::size_t N>
+struct context
+{
+  std::atomic<int> ticket{0};
+  int stamps[N] = {};
+};
+
+template <std::size_t Cost, typename Next = hrlib::static_graph::terminal_node>
+struct cost_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  static constexpr std::size_t cost = Cost;
+  template <typename NextNodeType>
+  constexpr cost_node<Cost, NextNodeType> copy() const { return cost_node<Cost, NextNodeType>{id}; }
+  std::size_t id = 0;
+  constexpr cost_node(std::size_t id): base_type(), id(id) {}
+  template <typename Context>
+  void run(Context& ctx) { ctx.stamps[id] = ++ctx.ticket; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct plain_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr plain_node<NextNodeType> copy() const { return plain_node<NextNodeType>{id}; }
+  std::size_t id = 0;
+  constexpr plain_node(std::size_t id): base_type(), id(id) {}
+  template <typename Context>
+  void run(Context& ctx) { ctx.stamps[id] = ++ctx.ticket; }
+};
+
+template <int Group, typename Next = hrlib::static_graph::terminal_node>
+struct group_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  static constexpr int affinity_group = Group;
+  template <typename NextNodeType>
+  constexpr group_node<Group, NextNodeType> copy() const { return group_node<Group, NextNodeType>{id}; }
+  std::size_t id = 0;
+  int cpu = -1;
+  constexpr group_node(std::size_t id): base_type(), id(id) {}
+  template <typename Context>
+  void run(Context& ctx)
+  {
+    ctx.stamps[id] = ++ctx.ticket;
+#if defined(__linux__)
+    cpu = sched_getcpu();
+#endif
+  }
+};
+
+// records the thread which copied it and the thread which ran it
+template <int Group, typename Next = hrlib::static_graph::terminal_node>
+struct state_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  static constexpr int affinity_group = Group;
+  template <typename NextNodeType>
+  state_node<Group, NextNodeType> copy() const { return state_node<Group, NextNodeType>{id}; }
+  std::size_t id = 0;
+  int runs = 0;
+  std::thread::id copied_on{};
+  std::thread::id ran_on{};
+  state_node(std::size_t id): base_type(), id(id) {}
+  state_node(const state_node& other): base_type(other), id(other.id), runs(other.runs), copied_on(std::this_thread::get_id()) {}
+  template <typename Context>
+  void run(Context& ctx)
+  {
+    ctx.stamps[id] = ++ctx.ticket;
+    ++runs;
+    ran_on = std::this_thread::get_id();
+  }
+};
+
+template <std::size_t N>
+constexpr bool equal(const std::array<std::size_t, N>& lhs, const std::array<std::size_t, N>& rhs)
+{
+  for (std::size_t i = 0; i < N; ++i)
+    if (lhs[i] != rhs[i])
+      return false;
+  return true;
+}
+
+template <typename Graph, std::size_t N>
+bool check_order(const context<N>& ctx)
+{
+  using adj = hrlib::static_graph::adjacency<Graph>;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    if (ctx.stamps[i] == 0)
+      return false;
+    for (auto successor: adj::successors_of(i))
+      if (ctx.stamps[i] >= ctx.stamps[successor])
+        return false;
+  }
+  return true;
+}
+
+template <typename Executor, typename Graph>
+void run_many(Executor& executor, Graph& graph)
+{
+  for (int i = 0; i < 1000; ++i)
+  {
+    context<Graph::node_num> ctx;
+    executor.run(graph, ctx);
+    assert(check_order<Graph>(ctx));
+  }
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  // 0 -> {1, 2}, 2 -> 3, {1, 3} -> 4
+  constexpr auto n1 = cost_node<2>{0} + (cost_node<10>{1} | (cost_node<3>{2} + cost_node<3>{3})) + cost_node<1>{4};
+  using graph1_type = std::remove_const_t<decltype(n1)>;
+  static_assert(node_cost_v<node_at_t<graph1_type, 1>> == 10);
+  static_assert(node_cost_v<plain_node<>> == 1);
+
+  using path = critical_path<graph1_type>;
+  static_assert(equal(path::costs, std::array<std::size_t, 5>{2, 10, 3, 3, 1}));
+  static_assert(equal(path::earliest_start, std::array<std::size_t, 5>{0, 2, 2, 5, 12}));
+  static_assert(path::length == 13);
+  static_assert(equal(path::latest_start, std::array<std::size_t, 5>{0, 2, 6, 9, 12}));
+  static_assert(equal(path::slack, std::array<std::size_t, 5>{0, 0, 4, 4, 0}));
+  static_assert(path::is_critical(1) && !path::is_critical(2));
+
+  // the long branch stays on worker 0, the short one goes to worker 1 and ends before the join
+  using schedule2 = list_schedule<graph1_type, 2>;
+  static_assert(equal(schedule2::worker, std::array<std::size_t, 5>{0, 0, 1, 1, 0}));
+  static_assert(equal(schedule2::start, std::array<std::size_t, 5>{0, 2, 2, 5, 12}));
+  static_assert(equal(schedule2::finish, std::array<std::size_t, 5>{2, 12, 5, 8, 13}));
+  static_assert(equal(schedule2::worker_offsets, std::array<std::size_t, 3>{0, 3, 5}));
+  static_assert(equal(schedule2::worker_nodes, std::array<std::size_t, 5>{0, 1, 4, 2, 3}));
+  static_assert(schedule2::makespan == 13);
+  static_assert(list_schedule<graph1_type, 1>::makespan == 19);
+  static_assert(list_schedule<graph1_type, 4>::makespan == 13);
+
+  static_assert(latency_lower_bound_v<graph1_type, 1> == 19);
+  static_assert(latency_lower_bound_v<graph1_type, 2> == 13);
+  static_assert(schedule2::makespan >= latency_lower_bound_v<graph1_type, 2>);
+
+  auto graph1 = n1;
+  scheduled_executor<graph1_type, 1> executor1;
+  run_many(executor1, graph1);
+  scheduled_executor<graph1_type, 2> executor2;
+  run_many(executor2, graph1);
+
+  constexpr auto n2 = plain_node<>{0} + (plain_node<>{1} + plain_node<>{2});
+  constexpr auto n3 = (plain_node<>{4} + plain_node<>{5}) + (plain_node<>{6} | plain_node<>{7});
+  constexpr auto n4 = n2 + (plain_node<>{3} | n3 | plain_node<>{8}) + (plain_node<>{9} + plain_node<>{10});
+  using graph2_type = std::remove_const_t<decltype(n4)>;
+  using schedule4 = list_schedule<graph2_type, 4>;
+  static_assert(critical_path<graph2_type>::length == 8);
+  static_assert(schedule4::makespan == latency_lower_bound_v<graph2_type, 4>);
+
+  auto graph2 = n4;
+  scheduled_executor<graph2_type, 4> executor4;
+  run_many(executor4, graph2);
+
+  // a group keeps its nodes on worker group % WorkerNum, the other nodes are placed as before
+  constexpr auto n5 = plain_node<>{0} + ((group_node<1>{1} + group_node<1>{2}) | (group_node<1>{3} + plain_node<>{4})) + plain_node<>{5};
+  using graph3_type = std::remove_const_t<decltype(n5)>;
+  static_assert(node_affinity_group_v<node_at_t<graph3_type, 1>> == 1);
+  static_assert(node_affinity_group_v<plain_node<>> == -1);
+  using schedule3 = list_schedule<graph3_type, 2>;
+  static_assert(equal(schedule3::worker, std::array<std::size_t, 6>{0, 1, 1, 1, 0, 0}));
+  static_assert(schedule3::makespan == 5);
+  static_assert(list_schedule<graph3_type, 3>::worker[3] == 1);
+
+  auto graph3 = n5;
+#if defined(__linux__)
+  const int cpu = sched_getcpu();
+  assert(pin_current_thread(cpu));
+  assert(!pin_current_thread(-1));
+  scheduled_executor<graph3_type, 2> pinned_executor(std::array<int, 2>{cpu, cpu});
+  assert(!pinned_executor.is_pinned(0) && pinned_executor.is_pinned(1));
+  run_many(pinned_executor, graph3);
+  assert(node_at<1>(graph3).cpu == cpu && node_at<3>(graph3).cpu == cpu);
+#endif
+  scheduled_executor<graph3_type, 2> unpinned_executor(std::array<int, 2>{-1, -1});
+  assert(!unpinned_executor.is_pinned(1));
+  run_many(unpinned_executor, graph3);
+
+  // place() copies every node on the worker which runs it, a group starts a new cache line
+  auto graph4 = state_node<0>{0} + ((state_node<1>{1} + state_node<1>{2}) | (state_node<2>{3} + state_node<2>{4})) + state_node<0>{5};
+  using graph4_type = decltype(graph4);
+  using schedule5 = list_schedule<graph4_type, 3>;
+  static_assert(equal(schedule5::worker, std::array<std::size_t, 6>{0, 1, 1, 2, 2, 0}));
+  scheduled_executor<graph4_type, 3> placing_executor;
+  assert(!placing_executor.is_placed());
+  placing_executor.place(graph4);
+  assert(placing_executor.is_placed());
+  for (int i = 0; i < 3; ++i)
+  {
+    context<graph4_type::node_num> ctx;
+    placing_executor.run_placed(ctx);
+    assert(check_order<graph4_type>(ctx));
+  }
+  const auto& p1 = placing_executor.placed_node<1>();
+  const auto& p2 = placing_executor.placed_node<2>();
+  const auto& p3 = placing_executor.placed_node<3>();
+  assert(p1.runs == 3 && p2.runs == 3 && p3.runs == 3 && node_at<1>(graph4).runs == 0);
+  assert(p1.copied_on == p1.ran_on && p2.copied_on == p2.ran_on && p3.copied_on == p3.ran_on);
+  assert(p1.copied_on != p3.copied_on && p1.copied_on != std::this_thread::get_id());
+  assert(placing_executor.placed_node<0>().copied_on == std::this_thread::get_id());
+  const auto line_of = [](const auto& node){ return reinterpret_cast<std::uintptr_t>(&node) / 64; };
+  assert(line_of(p1) != line_of(p3));
+  assert(line_of(placing_executor.placed_node<0>()) != line_of(p1));
+  // placing again replaces the copies
+  placing_executor.place(graph4);
+  assert(placing_executor.placed_node<1>().runs == 0);
+  return 0;
+}
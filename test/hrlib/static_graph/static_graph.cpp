@@ -23,7 +23,7 @@ constexpr std::pair<bool, std::size_t> constexpr_dfs_impl(Node* node, const int
   else
     return constexpr_dfs_impl(node->next, ans, index + 1);
 }
-template <std::size_t I = 0, std::size_t N, typename... Ns>
+template <std::size_t I, std::size_t N, typename... Ns>
 constexpr std::pair<bool, std::size_t> constexpr_dfs_impl(std::tuple<Ns...> nodes, const int (&ans)[N], std::size_t index)
 {
   if (std::get<I>(nodes)->value != ans[index])
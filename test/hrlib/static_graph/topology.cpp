@@ -0,0 +1,137 @@
+#include <type_traits>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/topology.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct indexed_node: hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next, hrlib::static_graph::index_link_tag>;
+  template <typename NextNodeType>
+  constexpr indexed_node<NextNodeType> copy() const { return indexed_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr indexed_node(int val): base_type(), value(val) {}
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct linked_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr linked_node<NextNodeType> copy() const { return linked_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr linked_node(int val): base_type(), value(val) {}
+};
+
+template <std::size_t I, typename Graph, typename Recorder>
+constexpr void dfs_impl(const Graph& graph, bool (&visited)[Graph::node_num], Recorder& rec);
+template <typename Graph, typename Recorder, std::size_t... Js>
+constexpr void dfs_successors(const Graph& graph, bool (&visited)[Graph::node_num], Recorder& rec, std::index_sequence<Js...>)
+{
+  (dfs_impl<Js>(graph, visited, rec), ...);
+}
+template <std::size_t I, typename Graph, typename Recorder>
+constexpr void dfs_impl(const Graph& graph, bool (&visited)[Graph::node_num], Recorder& rec)
+{
+  if (visited[I])
+    return;
+  visited[I] = true;
+  rec.push(hrlib::static_graph::node_at<I>(graph).value);
+  dfs_successors(graph, visited, rec, hrlib::static_graph::successors_t<Graph, I>{});
+}
+template <typename Graph, std::size_t N>
+constexpr bool index_dfs(const Graph& graph, const int (&ans)[N])
+{
+  bool visited[Graph::node_num] = {};
+  recorder<N> rec{};
+  dfs_impl<0>(graph, visited, rec);
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  constexpr auto n1 = indexed_node<>{1} + (indexed_node<>{2} + indexed_node<>{3});
+  constexpr auto n2 = (indexed_node<>{6} + indexed_node<>{5}) + indexed_node<>{4};
+  constexpr auto n3 = (indexed_node<>{7} + indexed_node<>{8}) + (indexed_node<>{9} | indexed_node<>{10});
+  constexpr auto n4 = n1 + (indexed_node<>{11} | n3 | indexed_node<>{12}) + n2;
+  using graph_type = std::remove_const_t<decltype(n4)>;
+
+  static_assert(single_node_constraints_v<indexed_node<>>);
+  static_assert(is_combinable_single_node_v<indexed_node<>>);
+  static_assert(is_index_linked_v<indexed_node<>>);
+  static_assert(!is_index_linked_v<single_node_base<>>);
+  static_assert(sizeof(indexed_node<>) == sizeof(int));
+  // a link to the terminal node takes no storage
+  static_assert(std::is_empty_v<single_node_base<>>);
+  static_assert(single_node_base<>::next == &terminal);
+  // an interior pointer link keeps its pointer, an index link stores nothing
+  static_assert(sizeof(linked_node<>) == sizeof(int));
+  static_assert(sizeof(linked_node<linked_node<>>) >= sizeof(int) + sizeof(void*));
+  static_assert(sizeof(indexed_node<indexed_node<>>) == sizeof(int));
+  static_assert(sizeof(linked_node<>{1} + linked_node<>{2} + linked_node<>{3}) >= 3 * sizeof(int) + 2 * sizeof(void*));
+  static_assert(sizeof(indexed_node<>{1} + indexed_node<>{2} + indexed_node<>{3}) == 3 * sizeof(int));
+
+  static_assert(std::is_same_v<node_index_t<12>, std::uint8_t>);
+  static_assert(std::is_same_v<node_index_t<255>, std::uint8_t>);
+  static_assert(std::is_same_v<node_index_t<256>, std::uint16_t>);
+  static_assert(std::is_same_v<node_index_t<70000>, std::uint32_t>);
+
+  static_assert(std::is_same_v<successors_t<graph_type, 2>, std::index_sequence<3, 4, 8>>);
+  static_assert(std::is_same_v<successors_t<graph_type, 5>, std::index_sequence<6, 7>>);
+  static_assert(std::is_same_v<successors_t<graph_type, 8>, std::index_sequence<9>>);
+  static_assert(std::is_same_v<successors_t<graph_type, 11>, std::index_sequence<>>);
+  static_assert(std::get<0>(successor_nodes<5>(n4)).value == 9);
+  static_assert(std::get<1>(successor_nodes<5>(n4)).value == 10);
+
+  using adj = adjacency<graph_type>;
+  static_assert(adj::node_num == 12 && adj::edge_num == 14);
+  static_assert(std::is_same_v<adj::index_type, std::uint8_t> && sizeof(adj::successors) == adj::edge_num);
+  static_assert(adj::offsets.size() == 13 && adj::offsets[12] == adj::edge_num);
+  static_assert(adj::out_degree[2] == 3 && adj::in_degree[2] == 1);
+  static_assert(adj::out_degree[11] == 0 && adj::in_degree[0] == 0);
+  static_assert(adj::in_degree[9] == 4 && adj::predecessors_of(9)[0] == 3 && adj::predecessors_of(9)[3] == 8);
+  static_assert(adj::successors_of(5).size() == 2 && adj::successors_of(5)[0] == 6 && adj::successors_of(5)[1] == 7);
+  static_assert(adj::successors_of(11).empty());
+  constexpr auto degree_sum = [](const auto& degrees){ std::size_t sum = 0; for (auto d: degrees) sum += d; return sum; };
+  static_assert(degree_sum(adj::in_degree) == adj::edge_num && degree_sum(adj::out_degree) == adj::edge_num);
+
+  static_assert(reachable_v<graph_type, 2, 7> && reachable_v<graph_type, 0, 11> && reachable_v<graph_type, 5, 5>);
+  static_assert(!reachable_v<graph_type, 3, 4> && !reachable_v<graph_type, 9, 2>);
+  static_assert(path_count_v<graph_type> == 4);
+  static_assert(depth_v<graph_type> == 9);
+  static_assert(width_v<graph_type> == 4);
+  static_assert(std::is_same_v<topological_order_t<graph_type>, std::index_sequence<0, 1, 2, 3, 4, 8, 5, 6, 7, 9, 10, 11>>);
+  static_assert(path_count_v<indexed_node<>> == 1 && depth_v<indexed_node<>> == 1 && width_v<indexed_node<>> == 1);
+
+  static constexpr int ans[graph_type::node_num] = {1, 2, 3, 11, 6, 5, 4, 7, 8, 9, 10, 12};
+  static constexpr int ans1[graph_type::node_num] = {1, 2, 3, 11, 6, 5, 4, 7, 8, 9, 10, 11};
+  static_assert(index_dfs(n4, ans));
+  static_assert(!index_dfs(n4, ans1));
+
+  // the links stay valid across copies and relocations without construct_connection()
+  static_assert(std::is_trivially_copy_constructible_v<graph_type>);
+  static_assert(std::is_trivially_destructible_v<graph_type>);
+  std::vector<graph_type> graphs;
+  for (int i = 0; i < 16; ++i)
+    graphs.push_back(n4);
+  for (const auto& graph: graphs)
+    assert(index_dfs(graph, ans));
+  auto moved = std::move(graphs.back());
+  assert(index_dfs(moved, ans));
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <type_traits>
+#include <vector>
+#include <cassert>
+#include <hrlib/static_graph/static_graph.hpp>
+#include <hrlib/static_graph/traversal.hpp>
+
+template <std::size_t N>
+struct recorder
+{
+  int values[N] = {};
+  std::size_t size = 0;
+  constexpr void push(int value) { values[size++] = value; }
+};
+
+template <typename Next = hrlib::static_graph::terminal_node>
+struct value_node: hrlib::static_graph::single_node_base<Next>
+{
+  using base_type = hrlib::static_graph::single_node_base<Next>;
+  template <typename NextNodeType>
+  constexpr value_node<NextNodeType> copy() const { return value_node<NextNodeType>{value}; }
+  int value = 0;
+  constexpr value_node(int val): base_type(), value(val) {}
+};
+
+template <std::size_t N>
+constexpr bool equal(const recorder<N>& rec, const int (&ans)[N])
+{
+  for (std::size_t i = 0; i < N; ++i)
+    if (rec.values[i] != ans[i])
+      return false;
+  return rec.size == N;
+}
+
+template <typename Graph, std::size_t N>
+constexpr bool check_dfs(const Graph& graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::dfs(graph, [&rec](const auto& node, std::size_t){ rec.push(node.value); });
+  return equal(rec, ans);
+}
+template <typename Graph, std::size_t N>
+constexpr bool check_bfs(const Graph& graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::bfs(graph, [&rec](const auto& node, std::size_t){ rec.push(node.value); });
+  return equal(rec, ans);
+}
+template <typename Graph, std::size_t N>
+constexpr bool check_topological(const Graph& graph, const int (&ans)[N])
+{
+  recorder<N> rec{};
+  hrlib::static_graph::topological_for_each(graph, [&rec](const auto& node, std::size_t){ rec.push(node.value); });
+  return equal(rec, ans);
+}
+
+// repeated traversals with the same graph_traversal, the marks are never cleared
+template <typename Graph>
+constexpr bool check_repeated(const Graph& graph, std::size_t times)
+{
+  hrlib::static_graph::graph_traversal<Graph> traversal{};
+  for (std::size_t t = 0; t < times; ++t)
+  {
+    std::size_t count = 0, index_sum = 0;
+    traversal.dfs(graph, [&](const auto&, std::size_t index){ ++count; index_sum += index; });
+    if (count != Graph::node_num || index_sum != Graph::node_num * (Graph::node_num - 1) / 2)
+      return false;
+  }
+  return true;
+}
+
+int main()
+{
+  using namespace hrlib::static_graph;
+  // the same graph and the same expected order as the hand written dfs in static_graph.cpp
+  constexpr auto n1 = value_node<>{1} + (value_node<>{2} + value_node<>{3});
+  constexpr auto n2 = (value_node<>{6} + value_node<>{5}) + value_node<>{4};
+  constexpr auto n3 = (value_node<>{7} + value_node<>{8}) + (value_node<>{9} | value_node<>{10});
+  constexpr auto n4 = n1 + (value_node<>{11} | n3 | value_node<>{12}) + n2;
+  static constexpr int dfs_ans[] = {1, 2, 3, 11, 6, 5, 4, 7, 8, 9, 10, 12};
+  static constexpr int bfs_ans[] = {1, 2, 3, 11, 7, 12, 6, 8, 5, 9, 10, 4};
+  static constexpr int topological_ans[] = {1, 2, 3, 11, 7, 8, 9, 10, 12, 6, 5, 4};
+  static_assert(check_dfs(n4, dfs_ans));
+  static_assert(check_bfs(n4, bfs_ans));
+  static_assert(check_topological(n4, topological_ans));
+  static_assert(check_repeated(n4, 3));
+
+  constexpr auto n5 = (value_node<>{11} | n3 | value_node<>{12}) + n2;
+  static constexpr int dfs_ans2[] = {11, 6, 5, 4, 7, 8, 9, 10, 12};
+  static_assert(check_dfs(n5, dfs_ans2));
+
+  auto graph = n4;
+  graph_traversal<decltype(graph)> traversal;
+  for (int t = 0; t < 1000; ++t)
+  {
+    std::vector<int> values;
+    traversal.dfs(graph, [&values](auto& node, std::size_t){ values.push_back(node.value); });
+    assert(values.size() == 12);
+    for (std::size_t i = 0; i < values.size(); ++i)
+      assert(values[i] == dfs_ans[i]);
+  }
+  return 0;
+}